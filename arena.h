@@ -0,0 +1,106 @@
+// 暫存用的 bump allocator：同一次化簡中的暫存陣列都從這裡切，呼叫結束後整批歸還
+// 區塊在 Reset / Release 後保留下來，穩定狀態下不再向 heap 要記憶體
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class Arena {
+public:
+    explicit Arena(size_t blockBytes = 64 * 1024) : blockBytes(blockBytes) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // 只用於 trivially copyable 的型別 (不會呼叫建構 / 解構子)
+    template <typename T>
+    T* Alloc(size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "arena only holds trivially copyable data");
+        return (T*)AllocBytes(count * sizeof(T), alignof(T) < 16 ? 16 : alignof(T));
+    }
+
+    template <typename T>
+    T* AllocZeroed(size_t count) {
+        T* p = Alloc<T>(count);
+        if (count) memset(p, 0, count * sizeof(T));
+        return p;
+    }
+
+    template <typename T>
+    T* AllocCopy(const T* src, size_t count) {
+        T* p = Alloc<T>(count);
+        if (count) memcpy(p, src, count * sizeof(T));
+        return p;
+    }
+
+    // 堆疊式歸還：Release(mark) 釋放 Mark() 之後配置的所有空間
+    struct Marker {
+        size_t block;
+        size_t offset;
+    };
+    Marker Mark() const { return { current, offset }; }
+    void Release(Marker m) { current = m.block; offset = m.offset; }
+    void Reset() { current = 0; offset = 0; }
+
+    // 向 heap 要過幾次區塊 (觀察穩定狀態是否還在配置)
+    size_t BlockAllocations() const { return blockAllocations; }
+
+private:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t current = 0; // 目前使用的區塊
+    size_t offset = 0;  // 目前區塊已使用的位元組
+    size_t blockBytes;
+    size_t blockAllocations = 0;
+
+    void* AllocBytes(size_t bytes, size_t align) {
+        while (true) {
+            if (current < blocks.size()) {
+                size_t start = (offset + align - 1) & ~(align - 1);
+                if (start + bytes <= blocks[current].size) {
+                    offset = start + bytes;
+                    return blocks[current].data.get() + start;
+                }
+                // 目前區塊放不下：換下一個已配置的區塊
+                if (current + 1 < blocks.size() && bytes + align <= blocks[current + 1].size) {
+                    current++;
+                    offset = 0;
+                    continue;
+                }
+            }
+            // 需要新區塊：插在 current 之後，之後的區塊保留給之後使用
+            size_t size = blockBytes;
+            while (size < bytes + align) size *= 2;
+            Block block = { std::unique_ptr<uint8_t[]>(new uint8_t[size]), size };
+            size_t at = blocks.empty() ? 0 : current + 1;
+            blocks.insert(blocks.begin() + at, std::move(block));
+            blockAllocations++;
+            current = at;
+            offset = 0;
+        }
+    }
+};
+
+// 範圍結束時自動 Release
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) : arena(arena), mark(arena.Mark()) {}
+    ~ArenaScope() { arena.Release(mark); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& arena;
+    Arena::Marker mark;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,618 @@
+#include "bdd.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+
+const uint32_t TERMINAL_VAR = 0xFFFFFFFFu;
+const uint32_t FREE_VAR = 0xFFFFFFFEu;
+const size_t BDD_GC_MIN_NODES = (size_t)1 << 20;
+const int NO_PATH = 1 << 30;
+const size_t BDD_PRIME_STEP_BUDGET = (size_t)1 << 22; // BddCover 建立質項 ZDD 的步數預算
+
+// 運算快取的運算代碼
+enum : uint32_t { OP_AND = 1, OP_OR, OP_XOR, OP_DIFF, OP_MEET, OP_PRIMES, OP_UNION, OP_ZDIFF, OP_TO_BDD };
+
+static inline size_t NodeHash(uint32_t var, BddRef lo, BddRef hi) {
+    uint64_t h = ((uint64_t)lo << 32 | hi) ^ (uint64_t)var * 0x9E3779B97F4A7C15ull;
+    h = (h ^ (h >> 31)) * 0xBF58476D1CE4E5B9ull;
+    return (size_t)(h ^ (h >> 32));
+}
+
+BddManager::BddManager(int numVars, int cacheBits)
+    : numVars(std::min(std::max(numVars, 0), BDD_MAX_VARS)), gcThreshold(BDD_GC_MIN_NODES) {
+    nodes.push_back({ TERMINAL_VAR, BDD_ZERO, BDD_ZERO, 0 });
+    nodes.push_back({ TERMINAL_VAR, BDD_ONE, BDD_ONE, 0 });
+    refs.assign(2, 0);
+    buckets.assign(1024, 0);
+    cache.assign((size_t)1 << cacheBits, CacheEntry{ 0, 0, 0, 0 });
+}
+
+// --- 節點表 ---
+BddRef BddManager::MakeNode(uint32_t var, BddRef lo, BddRef hi) {
+    const size_t h = NodeHash(var, lo, hi) & (buckets.size() - 1);
+    for (uint32_t i = buckets[h]; i; i = nodes[i].next) {
+        if (nodes[i].var == var && nodes[i].lo == lo && nodes[i].hi == hi) return i;
+    }
+    BddRef id;
+    if (freeList) {
+        id = freeList;
+        freeList = nodes[id].next;
+        freeCount--;
+        nodes[id] = { var, lo, hi, buckets[h] };
+        refs[id] = 0;
+    } else {
+        id = (BddRef)nodes.size();
+        nodes.push_back({ var, lo, hi, buckets[h] });
+        refs.push_back(0);
+    }
+    buckets[h] = id;
+    if (nodes.size() > buckets.size()) Rehash(buckets.size() * 2);
+    return id;
+}
+
+void BddManager::Rehash(size_t bucketCount) {
+    buckets.assign(bucketCount, 0);
+    for (uint32_t i = 2; i < nodes.size(); i++) {
+        if (nodes[i].var == FREE_VAR) continue;
+        size_t h = NodeHash(nodes[i].var, nodes[i].lo, nodes[i].hi) & (bucketCount - 1);
+        nodes[i].next = buckets[h];
+        buckets[h] = i;
+    }
+}
+
+BddRef BddManager::Ref(BddRef f) {
+    refs[f]++;
+    return f;
+}
+
+void BddManager::Deref(BddRef f) {
+    if (refs[f]) refs[f]--;
+}
+
+// 標記所有從 Ref 過的節點可到達的節點，其餘放回 free list
+void BddManager::Collect() {
+    std::vector<uint8_t> live(nodes.size(), 0);
+    live[BDD_ZERO] = live[BDD_ONE] = 1;
+    std::vector<BddRef> stack;
+    for (uint32_t i = 2; i < nodes.size(); i++) if (refs[i] && nodes[i].var != FREE_VAR) stack.push_back(i);
+    while (!stack.empty()) {
+        BddRef f = stack.back();
+        stack.pop_back();
+        if (live[f]) continue;
+        live[f] = 1;
+        stack.push_back(nodes[f].lo);
+        stack.push_back(nodes[f].hi);
+    }
+
+    freeList = 0;
+    freeCount = 0;
+    for (uint32_t i = (uint32_t)nodes.size() - 1; i >= 2; i--) {
+        if (live[i]) continue;
+        nodes[i] = { FREE_VAR, 0, 0, freeList };
+        refs[i] = 0;
+        freeList = i;
+        freeCount++;
+    }
+    Rehash(buckets.size());
+    for (CacheEntry& e : cache) e.op = 0;
+    gcThreshold = std::max(gcThreshold, NodeCount() * 2);
+}
+
+// 公開運算開始時呼叫：清除 overflow，需要時回收 (參數暫時 Ref，避免被回收)
+void BddManager::Begin(BddRef a, BddRef b) {
+    overflow = false;
+    steps = 0;
+    if (NodeCount() < gcThreshold) return;
+    refs[a]++;
+    refs[b]++;
+    Collect();
+    refs[a]--;
+    refs[b]--;
+}
+
+size_t BddManager::DagSize(BddRef f) const {
+    std::unordered_set<BddRef> seen;
+    std::vector<BddRef> stack = { f };
+    while (!stack.empty()) {
+        BddRef g = stack.back();
+        stack.pop_back();
+        if (!seen.insert(g).second || g <= BDD_ONE) continue;
+        stack.push_back(nodes[g].lo);
+        stack.push_back(nodes[g].hi);
+    }
+    return seen.size();
+}
+
+// --- 運算快取 (直接映射，衝突時覆蓋) ---
+// 每個遞迴步驟都會查一次快取，步數上限也在這裡檢查 (超過時當作查到 BDD_ZERO)
+bool BddManager::CacheLookup(uint32_t op, BddRef a, BddRef b, BddRef& result) {
+    if (stepLimit && ++steps > stepLimit) {
+        overflow = true;
+        result = BDD_ZERO;
+        return true;
+    }
+    const CacheEntry& e = cache[NodeHash(op, a, b) & (cache.size() - 1)];
+    if (e.op != op || e.a != a || e.b != b) return false;
+    result = e.result;
+    return true;
+}
+
+void BddManager::CacheInsert(uint32_t op, BddRef a, BddRef b, BddRef result) {
+    cache[NodeHash(op, a, b) & (cache.size() - 1)] = { op, a, b, result };
+}
+
+// --- BDD ---
+// 節點陣列在遞迴中可能重新配置，子節點一律先複製出來再遞迴
+BddRef BddManager::Apply(uint32_t op, BddRef a, BddRef b) {
+    if (overflow) return BDD_ZERO;
+    switch (op) {
+    case OP_AND:
+        if (a == BDD_ZERO || b == BDD_ZERO) return BDD_ZERO;
+        if (a == BDD_ONE || a == b) return b;
+        if (b == BDD_ONE) return a;
+        break;
+    case OP_OR:
+        if (a == BDD_ONE || b == BDD_ONE) return BDD_ONE;
+        if (a == BDD_ZERO || a == b) return b;
+        if (b == BDD_ZERO) return a;
+        break;
+    case OP_XOR:
+        if (a == b) return BDD_ZERO;
+        if (a == BDD_ZERO) return b;
+        if (b == BDD_ZERO) return a;
+        break;
+    case OP_DIFF:
+        if (a == BDD_ZERO || b == BDD_ONE || a == b) return BDD_ZERO;
+        if (b == BDD_ZERO) return a;
+        break;
+    }
+    if (op != OP_DIFF && a > b) std::swap(a, b);
+    BddRef r;
+    if (CacheLookup(op, a, b, r)) return r;
+
+    const uint32_t va = nodes[a].var, vb = nodes[b].var, v = std::min(va, vb);
+    const BddRef a0 = va == v ? nodes[a].lo : a, a1 = va == v ? nodes[a].hi : a;
+    const BddRef b0 = vb == v ? nodes[b].lo : b, b1 = vb == v ? nodes[b].hi : b;
+    BddRef lo = Apply(op, a0, b0);
+    BddRef hi = Apply(op, a1, b1);
+    r = BddNode(v, lo, hi);
+    if (overflow) return BDD_ZERO;
+    CacheInsert(op, a, b, r);
+    return r;
+}
+
+// 找到一條兩者都走到 1 的路徑就結束，結果 (BDD_ZERO / BDD_ONE) 同樣記在運算快取
+bool BddManager::IntersectsRec(BddRef a, BddRef b) {
+    if (a == BDD_ZERO || b == BDD_ZERO) return false;
+    if (a == BDD_ONE || b == BDD_ONE || a == b) return true;
+    if (a > b) std::swap(a, b);
+    BddRef r;
+    if (CacheLookup(OP_MEET, a, b, r)) return r == BDD_ONE;
+    const uint32_t va = nodes[a].var, vb = nodes[b].var, v = std::min(va, vb);
+    const BddRef a0 = va == v ? nodes[a].lo : a, a1 = va == v ? nodes[a].hi : a;
+    const BddRef b0 = vb == v ? nodes[b].lo : b, b1 = vb == v ? nodes[b].hi : b;
+    const bool meet = IntersectsRec(a0, b0) || IntersectsRec(a1, b1);
+    if (overflow) return false;
+    CacheInsert(OP_MEET, a, b, meet ? BDD_ONE : BDD_ZERO);
+    return meet;
+}
+
+bool BddManager::Intersects(BddRef f, BddRef g) {
+    Begin(f, g);
+    return IntersectsRec(f, g);
+}
+
+BddRef BddManager::Var(int v) {
+    Begin(BDD_ZERO, BDD_ZERO);
+    return BddNode((uint32_t)v, BDD_ZERO, BDD_ONE);
+}
+
+BddRef BddManager::Not(BddRef f) { return Xor(f, BDD_ONE); }
+
+BddRef BddManager::And(BddRef f, BddRef g) {
+    Begin(f, g);
+    return Apply(OP_AND, f, g);
+}
+
+BddRef BddManager::Or(BddRef f, BddRef g) {
+    Begin(f, g);
+    return Apply(OP_OR, f, g);
+}
+
+BddRef BddManager::Xor(BddRef f, BddRef g) {
+    Begin(f, g);
+    return Apply(OP_XOR, f, g);
+}
+
+BddRef BddManager::Diff(BddRef f, BddRef g) {
+    Begin(f, g);
+    return Apply(OP_DIFF, f, g);
+}
+
+// 由最後一個變數往上建立 (只看前 numVars 個欄位)
+BddRef BddManager::FromCube(Cube c) {
+    Begin(BDD_ZERO, BDD_ZERO);
+    BddRef r = BDD_ONE;
+    for (int v = numVars - 1; v >= 0; v--) {
+        switch (CubeVarValue(c, v)) {
+        case 0: return BDD_ZERO;
+        case 1: r = BddNode((uint32_t)v, r, BDD_ZERO); break;
+        case 2: r = BddNode((uint32_t)v, BDD_ZERO, r); break;
+        default: break;
+        }
+    }
+    return r;
+}
+
+BddRef BddManager::FromCubes(const CubeList& cubes) {
+    BddRef r = BDD_ZERO;
+    for (Cube c : cubes) {
+        Ref(r);
+        BddRef cube = FromCube(c);
+        Deref(r);
+        r = Or(r, cube);
+        if (overflow) return BDD_ZERO;
+    }
+    return r;
+}
+
+// 排序後的 minterm：第 v 層依 A..的第 v 個位元切成兩段
+BddRef BddManager::MintermsRec(const uint32_t* begin, const uint32_t* end, int v) {
+    if (begin == end) return BDD_ZERO;
+    if (v == numVars) return BDD_ONE;
+    const int bit = numVars - 1 - v;
+    const uint32_t* mid = std::partition_point(begin, end, [bit](uint32_t m) { return ((m >> bit) & 1) == 0; });
+    BddRef lo = MintermsRec(begin, mid, v + 1);
+    BddRef hi = MintermsRec(mid, end, v + 1);
+    return BddNode((uint32_t)v, lo, hi);
+}
+
+BddRef BddManager::FromMinterms(const std::vector<uint32_t>& minterms) {
+    Begin(BDD_ZERO, BDD_ZERO);
+    std::vector<uint32_t> sorted;
+    for (uint32_t m : minterms) if (numVars == 32 || (m >> numVars) == 0) sorted.push_back(m);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return MintermsRec(sorted.data(), sorted.data() + sorted.size(), 0);
+}
+
+// 第 v 層的區段為 base 起的 2^(numVars - v) 個 minterm；6 層以內在同一個 word 中，全 0 / 全 1 時直接回傳常數
+BddRef BddManager::TruthTableRec(const TruthTable& t, int v, uint32_t base) {
+    const int span = numVars - v;
+    if (span <= 6) {
+        const uint64_t full = span == 6 ? ~0ull : (1ull << (1u << span)) - 1;
+        const uint64_t bits = (t.Words()[base >> 6] >> (base & 63)) & full;
+        if (bits == 0) return BDD_ZERO;
+        if (bits == full) return BDD_ONE;
+    }
+    BddRef lo = TruthTableRec(t, v + 1, base);
+    BddRef hi = TruthTableRec(t, v + 1, base + (1u << (span - 1)));
+    return BddNode((uint32_t)v, lo, hi);
+}
+
+BddRef BddManager::FromTruthTable(const TruthTable& t) {
+    if (t.NumVars() != numVars || numVars > TRUTH_TABLE_MAX_VARS) return BDD_ZERO;
+    Begin(BDD_ZERO, BDD_ZERO);
+    return TruthTableRec(t, 0, 0);
+}
+
+// 各節點為 1 的比例 = 兩個子節點比例的平均 (與略過的層無關)
+double BddManager::SatCount(BddRef f) const {
+    std::unordered_map<BddRef, double> memo;
+    struct Counter {
+        const std::vector<Node>& nodes;
+        std::unordered_map<BddRef, double>& memo;
+        double Run(BddRef g) {
+            if (g <= BDD_ONE) return g == BDD_ONE ? 1.0 : 0.0;
+            auto it = memo.find(g);
+            if (it != memo.end()) return it->second;
+            double r = 0.5 * (Run(nodes[g].lo) + Run(nodes[g].hi));
+            memo[g] = r;
+            return r;
+        }
+    } counter{ nodes, memo };
+    return std::ldexp(counter.Run(f), numVars);
+}
+
+Cube BddManager::SatOne(BddRef f) const {
+    if (f == BDD_ZERO) return 0;
+    Cube c = CubeNormalize(0, numVars);
+    for (int v = 0; v < numVars; v++) c |= 1ull << (2 * v);
+    while (f != BDD_ONE) {
+        const Node& n = nodes[f];
+        if (n.lo != BDD_ZERO) {
+            f = n.lo;
+        } else {
+            c = (c & ~CubeVarField((int)n.var)) | (2ull << (2 * n.var));
+            f = n.hi;
+        }
+    }
+    return c;
+}
+
+// --- ZDD ---
+BddRef BddManager::UnionRec(BddRef a, BddRef b) {
+    if (a == BDD_ZERO) return b;
+    if (b == BDD_ZERO || a == b) return a;
+    if (a > b) std::swap(a, b);
+    BddRef r;
+    if (CacheLookup(OP_UNION, a, b, r)) return r;
+    const Node na = nodes[a], nb = nodes[b];
+    if (na.var < nb.var) {
+        r = ZddNode(na.var, UnionRec(na.lo, b), na.hi);
+    } else if (na.var > nb.var) {
+        r = ZddNode(nb.var, UnionRec(a, nb.lo), nb.hi);
+    } else {
+        BddRef lo = UnionRec(na.lo, nb.lo);
+        BddRef hi = UnionRec(na.hi, nb.hi);
+        r = ZddNode(na.var, lo, hi);
+    }
+    if (overflow) return BDD_ZERO;
+    CacheInsert(OP_UNION, a, b, r);
+    return r;
+}
+
+BddRef BddManager::DiffRec(BddRef a, BddRef b) {
+    if (a == BDD_ZERO || a == b) return BDD_ZERO;
+    if (b == BDD_ZERO) return a;
+    BddRef r;
+    if (CacheLookup(OP_ZDIFF, a, b, r)) return r;
+    const Node na = nodes[a], nb = nodes[b];
+    if (na.var < nb.var) {
+        r = ZddNode(na.var, DiffRec(na.lo, b), na.hi);
+    } else if (na.var > nb.var) {
+        r = DiffRec(a, nb.lo);
+    } else {
+        BddRef lo = DiffRec(na.lo, nb.lo);
+        BddRef hi = DiffRec(na.hi, nb.hi);
+        r = ZddNode(na.var, lo, hi);
+    }
+    if (overflow) return BDD_ZERO;
+    CacheInsert(OP_ZDIFF, a, b, r);
+    return r;
+}
+
+// 不依賴 v 的質項為 f0 f1 的質項；含 v' 的質項去掉 v' 後為 f0 的質項中不蘊含 f1 者
+// (f0 的質項蘊含 f1 時必為 f0 f1 的質項，反之亦然，因此以集合差求得)
+BddRef BddManager::PrimesRec(BddRef f) {
+    if (overflow) return BDD_ZERO;
+    if (f <= BDD_ONE) return f;
+    BddRef r;
+    if (CacheLookup(OP_PRIMES, f, 0, r)) return r;
+    const Node n = nodes[f];
+    BddRef both = PrimesRec(Apply(OP_AND, n.lo, n.hi));
+    BddRef p0 = DiffRec(PrimesRec(n.lo), both);
+    BddRef p1 = DiffRec(PrimesRec(n.hi), both);
+    r = ZddNode(2 * n.var, ZddNode(2 * n.var + 1, both, p1), p0);
+    if (overflow) return BDD_ZERO;
+    CacheInsert(OP_PRIMES, f, 0, r);
+    return r;
+}
+
+BddRef BddManager::ZddToBddRec(BddRef z) {
+    if (z <= BDD_ONE) return z;
+    BddRef r;
+    if (CacheLookup(OP_TO_BDD, z, 0, r)) return r;
+    const Node n = nodes[z];
+    const uint32_t v = n.var / 2;
+    BddRef lo = ZddToBddRec(n.lo);
+    BddRef hi = ZddToBddRec(n.hi);
+    BddRef literal = (n.var & 1) ? BddNode(v, BDD_ZERO, BDD_ONE) : BddNode(v, BDD_ONE, BDD_ZERO);
+    r = Apply(OP_OR, lo, Apply(OP_AND, literal, hi));
+    if (overflow) return BDD_ZERO;
+    CacheInsert(OP_TO_BDD, z, 0, r);
+    return r;
+}
+
+BddRef BddManager::Primes(BddRef f) {
+    Begin(f, BDD_ZERO);
+    return PrimesRec(f);
+}
+
+BddRef BddManager::ZddUnion(BddRef a, BddRef b) {
+    Begin(a, b);
+    return UnionRec(a, b);
+}
+
+BddRef BddManager::ZddDiff(BddRef a, BddRef b) {
+    Begin(a, b);
+    return DiffRec(a, b);
+}
+
+BddRef BddManager::ZddToBdd(BddRef z) {
+    Begin(z, BDD_ZERO);
+    return ZddToBddRec(z);
+}
+
+double BddManager::ZddCount(BddRef z) const {
+    std::unordered_map<BddRef, double> memo;
+    struct Counter {
+        const std::vector<Node>& nodes;
+        std::unordered_map<BddRef, double>& memo;
+        double Run(BddRef g) {
+            if (g <= BDD_ONE) return g == BDD_ONE ? 1.0 : 0.0;
+            auto it = memo.find(g);
+            if (it != memo.end()) return it->second;
+            double r = Run(nodes[g].lo) + Run(nodes[g].hi);
+            memo[g] = r;
+            return r;
+        }
+    } counter{ nodes, memo };
+    return counter.Run(z);
+}
+
+static inline Cube AddLiteral(Cube c, uint32_t literal) {
+    return c & CubeLiteral((int)(literal / 2), (int)(literal & 1));
+}
+
+CubeList BddManager::ZddCubes(BddRef z, size_t limit) const {
+    CubeList cubes;
+    struct Walker {
+        const std::vector<Node>& nodes;
+        CubeList& cubes;
+        size_t limit;
+        void Run(BddRef g, Cube path) {
+            if (g == BDD_ZERO || (limit && cubes.size() >= limit)) return;
+            if (g == BDD_ONE) { cubes.push_back(path); return; }
+            const Node& n = nodes[g];
+            Run(n.hi, AddLiteral(path, n.var));
+            Run(n.lo, path);
+        }
+    } walker{ nodes, cubes, limit };
+    walker.Run(z, CUBE_UNIVERSE);
+    return cubes;
+}
+
+// 備忘以節點索引加上戳記存放，每次呼叫換一個戳記，不重新配置
+void BddManager::NewMemo() const {
+    if (memoStamp.size() < nodes.size()) {
+        memoStamp.resize(nodes.size(), 0);
+        memoValue.resize(nodes.size());
+    }
+    if (++stampValue == 0) {
+        std::fill(memoStamp.begin(), memoStamp.end(), 0);
+        stampValue = 1;
+    }
+}
+
+// 與 c 相容的路徑都要走到 1；走到 0 立即結束，已確認的節點記在備忘中
+// 不建立節點，比 Implies(FromCube(c), f) 少走很多 (放寬失敗時通常很快就碰到 0)
+bool BddManager::CubeImplies(Cube c, BddRef f) const {
+    NewMemo();
+    struct Checker {
+        const BddManager& mgr;
+        Cube c;
+        bool Run(BddRef g) {
+            if (g <= BDD_ONE) return g == BDD_ONE;
+            if (mgr.memoStamp[g] == mgr.stampValue) return true;
+            const Node& n = mgr.nodes[g];
+            const int field = CubeVarValue(c, (int)n.var);
+            if ((field & 1) && !Run(n.lo)) return false;
+            if ((field & 2) && !Run(n.hi)) return false;
+            mgr.memoStamp[g] = mgr.stampValue;
+            return true;
+        }
+    } checker{ *this, c };
+    return CubeIsEmpty(CubeNormalize(c, numVars)) || checker.Run(f);
+}
+
+// 各節點之下與 minterm 相容的路徑中最少的字母數，再沿最短路徑取出乘積項
+// 覆蓋時每一項都要呼叫一次
+Cube BddManager::ZddMinCubeContaining(BddRef z, Cube minterm) const {
+    NewMemo();
+    struct Finder {
+        const BddManager& mgr;
+        Cube minterm;
+        bool Agrees(uint32_t literal) const {
+            return CubeVarValue(minterm, (int)(literal / 2)) == ((literal & 1) ? 2 : 1);
+        }
+        int Run(BddRef g) {
+            if (g <= BDD_ONE) return g == BDD_ONE ? 0 : NO_PATH;
+            if (mgr.memoStamp[g] == mgr.stampValue) return mgr.memoValue[g];
+            const Node& n = mgr.nodes[g];
+            int r = Run(n.lo);
+            if (Agrees(n.var)) r = std::min(r, Run(n.hi) + 1);
+            mgr.memoStamp[g] = mgr.stampValue;
+            mgr.memoValue[g] = r;
+            return r;
+        }
+    } finder{ *this, minterm };
+    if (finder.Run(z) >= NO_PATH) return 0;
+
+    Cube c = CUBE_UNIVERSE;
+    while (z != BDD_ONE) {
+        const Node& n = nodes[z];
+        if (finder.Agrees(n.var) && finder.Run(n.hi) + 1 == finder.Run(z)) {
+            c = AddLiteral(c, n.var);
+            z = n.hi;
+        } else {
+            z = n.lo;
+        }
+    }
+    return c;
+}
+
+// --- 化簡 ---
+// minterm 逐一放寬變數，仍在 upper 之內就保留 (放寬不了任何變數時即為質項)
+static Cube ExpandToPrime(BddManager& mgr, Cube c, BddRef upper) {
+    for (int v = 0; v < mgr.NumVars(); v++) {
+        Cube wider = c | CubeVarField(v);
+        if (wider != c && mgr.CubeImplies(wider, upper)) c = wider;
+    }
+    return c;
+}
+
+CubeList BddCover(BddManager& mgr, BddRef on, BddRef upper, BddStats* stats) {
+    CubeList cover;
+    std::vector<BddRef> cubeFns;
+    mgr.Ref(on);
+    mgr.Ref(upper);
+
+    // 質項 ZDD 超過預算時放棄，改為逐一把 minterm 放寬成質項
+    const size_t limit = mgr.StepLimit();
+    mgr.SetStepLimit(BDD_PRIME_STEP_BUDGET);
+    BddRef primes = mgr.Primes(upper);
+    const bool implicit = !mgr.Overflow();
+    mgr.SetStepLimit(limit);
+    if (!implicit) {
+        primes = BDD_ZERO;
+        mgr.Collect();
+    }
+    mgr.Ref(primes);
+
+    BddRef uncovered = mgr.Ref(on);
+    while (uncovered != BDD_ZERO) {
+        Cube minterm = mgr.SatOne(uncovered);
+        Cube p = implicit ? mgr.ZddMinCubeContaining(primes, minterm) : ExpandToPrime(mgr, minterm, upper);
+        if (p == 0 || !mgr.CubeImplies(minterm, upper)) break; // on 不在 upper 之內
+        BddRef fn = mgr.Ref(mgr.FromCube(p));
+        BddRef next = mgr.Ref(mgr.Diff(uncovered, fn));
+        mgr.Deref(uncovered);
+        uncovered = next;
+        cover.push_back(p);
+        cubeFns.push_back(fn);
+    }
+    mgr.Deref(uncovered);
+
+    // 由後往前：第 i 項覆蓋的 on-set 已被前面的項與後面留下的項覆蓋時拿掉
+    // 其他項的聯集通常就是整個函數，因此只取與第 i 項相交的部分建 BDD
+    std::vector<char> keep(cover.size(), 1);
+    for (size_t i = cover.size(); i-- > 0;) {
+        CubeList others;
+        for (size_t j = 0; j < cover.size(); j++) {
+            if (j != i && keep[j] && CubesIntersect(cover[i], cover[j])) others.push_back(cover[i] & cover[j]);
+        }
+        BddRef rest = mgr.Ref(mgr.FromCubes(others));
+        BddRef alone = mgr.Ref(mgr.Diff(cubeFns[i], rest));
+        if (!mgr.Intersects(alone, on)) keep[i] = 0;
+        mgr.Deref(rest);
+        mgr.Deref(alone);
+    }
+    for (BddRef f : cubeFns) mgr.Deref(f);
+
+    CubeList result;
+    for (size_t i = 0; i < cover.size(); i++) if (keep[i]) result.push_back(cover[i]);
+    if (stats) {
+        stats->onMinterms = mgr.SatCount(on);
+        stats->implicitPrimes = implicit;
+        stats->primes = implicit ? mgr.ZddCount(primes) : 0;
+        stats->primeNodes = implicit ? mgr.DagSize(primes) : 0;
+        stats->peakNodes = mgr.NodeCount();
+    }
+    mgr.Deref(primes);
+    mgr.Deref(upper);
+    mgr.Deref(on);
+    return result;
+}
+
+CubeList SolveBdd(int numVars, const CubeList& onSet, const CubeList& dcSet, BddStats* stats) {
+    if (numVars < 1 || numVars > BDD_MAX_VARS) return CubeList();
+    BddManager mgr(numVars);
+    BddRef on = mgr.Ref(mgr.FromCubes(onSet));
+    BddRef dc = mgr.Ref(mgr.FromCubes(dcSet));
+    BddRef upper = mgr.Ref(mgr.Or(on, dc));
+    CubeList cover = BddCover(mgr, on, upper, stats);
+    for (Cube& c : cover) c = CubeNormalize(c, numVars);
+    return cover;
+}
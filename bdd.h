@@ -0,0 +1,150 @@
+// 化簡後有序二元決策圖 (ROBDD) 與零抑制決策圖 (ZDD)：共用一張節點表 (unique table) 與運算快取
+// 函數以 BDD 表示、質項集合以 ZDD 隱式表示，on-set 有上百萬個 minterm 時也不必列出 minterm 或候選項
+//   BDD：變數 v (0 = A) 即為層級，lo / hi 為 v = 0 / 1 的餘因子；BDD_ZERO / BDD_ONE 為常數 0 / 1
+//   ZDD：乘積項的集合族，字母變數 2v = v'、2v + 1 = v；BDD_ZERO 為空集合族，BDD_ONE 為只有常數 1 的集合族
+// 節點以外部參照計數保護：要在之後的運算中繼續使用的結果須 Ref，不用時 Deref
+// 每個公開運算開始時若節點數超過門檻就回收未被參照的節點 (運算本身的參數不會被回收)
+// 可設定每個運算的遞迴步數上限：超過時放棄並回傳 BDD_ZERO，Overflow() 為 true (直到下一個公開運算)
+#ifndef BDD_H
+#define BDD_H
+
+#include "cube.h"
+#include "truth_table.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef uint32_t BddRef;
+
+const BddRef BDD_ZERO = 0;
+const BddRef BDD_ONE = 1;
+const int BDD_MAX_VARS = CUBE_MAX_VARS;
+
+class BddManager {
+public:
+    // cacheBits：運算快取 2^cacheBits 格
+    explicit BddManager(int numVars, int cacheBits = 18);
+
+    int NumVars() const { return numVars; }
+
+    BddRef Ref(BddRef f);
+    void Deref(BddRef f);
+    // 目前使用中的節點數 (含常數)
+    size_t NodeCount() const { return nodes.size() - freeCount; }
+    // 從 f 可到達的節點數 (含常數)
+    size_t DagSize(BddRef f) const;
+    // 立即回收所有未被 Ref 的節點 (同時清空運算快取)
+    void Collect();
+    // 0 = 不限
+    void SetStepLimit(size_t limit) { stepLimit = limit; }
+    size_t StepLimit() const { return stepLimit; }
+    // 最近一次運算因超過步數上限而放棄
+    bool Overflow() const { return overflow; }
+
+    // --- BDD ---
+    BddRef Var(int v);
+    BddRef Not(BddRef f);
+    BddRef And(BddRef f, BddRef g);
+    BddRef Or(BddRef f, BddRef g);
+    BddRef Xor(BddRef f, BddRef g);
+    // f & ~g
+    BddRef Diff(BddRef f, BddRef g);
+    bool Implies(BddRef f, BddRef g) { return Diff(f, g) == BDD_ZERO; }
+    // f & g 不為 0 (不建立節點)
+    bool Intersects(BddRef f, BddRef g);
+
+    BddRef FromCube(Cube c);
+    BddRef FromCubes(const CubeList& cubes);
+    // minterm 編號與 QM 相同 (A 為最高位元)，超出範圍的會被忽略
+    BddRef FromMinterms(const std::vector<uint32_t>& minterms);
+    // t.NumVars() 須等於 NumVars()
+    BddRef FromTruthTable(const TruthTable& t);
+
+    // 乘積項 c 整個在 f 之內 (不建立節點)
+    bool CubeImplies(Cube c, BddRef f) const;
+
+    // f 為 1 的 minterm 數 (以 double 表示，32 變數時仍精確)
+    double SatCount(BddRef f) const;
+    // f 中的一個 minterm (沿 lo 優先的路徑，未出現的變數取 0)；f 為 0 時回傳 0
+    Cube SatOne(BddRef f) const;
+
+    // --- ZDD ---
+    // f 的全部質項 (Coudert–Madre 遞迴：P(f) = P(f0 f1) ∪ v'·(P(f0) - P(f0 f1)) ∪ v·(P(f1) - P(f0 f1)))
+    BddRef Primes(BddRef f);
+    BddRef ZddUnion(BddRef a, BddRef b);
+    BddRef ZddDiff(BddRef a, BddRef b);
+    // 集合族中的乘積項數
+    double ZddCount(BddRef z) const;
+    // 集合族中所有乘積項的聯集 (BDD)
+    BddRef ZddToBdd(BddRef z);
+    // 列出乘積項 (limit = 0 表示不限)
+    CubeList ZddCubes(BddRef z, size_t limit = 0) const;
+    // 包含 minterm 的乘積項中字母最少的一個；沒有時回傳 0
+    Cube ZddMinCubeContaining(BddRef z, Cube minterm) const;
+
+private:
+    struct Node {
+        uint32_t var;  // 常數為 TERMINAL_VAR，已回收為 FREE_VAR
+        BddRef lo, hi;
+        uint32_t next; // unique table 的串列，或回收後的 free list (0 = 結尾)
+    };
+    struct CacheEntry {
+        uint32_t op; // 0 = 空
+        BddRef a, b, result;
+    };
+
+    int numVars;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> refs;
+    std::vector<uint32_t> buckets;
+    std::vector<CacheEntry> cache;
+    uint32_t freeList = 0;
+    size_t freeCount = 0;
+    size_t gcThreshold;
+    size_t stepLimit = 0;
+    size_t steps = 0;
+    bool overflow = false;
+    // ZddMinCubeContaining / CubeImplies 的備忘
+    mutable std::vector<uint32_t> memoStamp;
+    mutable std::vector<int> memoValue;
+    mutable uint32_t stampValue = 0;
+
+    BddRef MakeNode(uint32_t var, BddRef lo, BddRef hi);
+    BddRef BddNode(uint32_t var, BddRef lo, BddRef hi) { return lo == hi ? lo : MakeNode(var, lo, hi); }
+    BddRef ZddNode(uint32_t var, BddRef lo, BddRef hi) { return hi == BDD_ZERO ? lo : MakeNode(var, lo, hi); }
+    void Rehash(size_t bucketCount);
+    void Begin(BddRef a, BddRef b);
+    void NewMemo() const;
+
+    bool CacheLookup(uint32_t op, BddRef a, BddRef b, BddRef& result);
+    void CacheInsert(uint32_t op, BddRef a, BddRef b, BddRef result);
+
+    BddRef Apply(uint32_t op, BddRef a, BddRef b);
+    bool IntersectsRec(BddRef a, BddRef b);
+    BddRef PrimesRec(BddRef f);
+    BddRef UnionRec(BddRef a, BddRef b);
+    BddRef DiffRec(BddRef a, BddRef b);
+    BddRef ZddToBddRec(BddRef z);
+    BddRef MintermsRec(const uint32_t* begin, const uint32_t* end, int v);
+    BddRef TruthTableRec(const TruthTable& t, int v, uint32_t base);
+};
+
+// --- 化簡 ---
+struct BddStats {
+    double onMinterms = 0;       // on-set 的 minterm 數
+    bool implicitPrimes = false; // 質項 ZDD 在節點預算內建成
+    double primes = 0;           // onSet ∪ dcSet 的質項數 (只以 ZDD 表示，未列出)
+    size_t primeNodes = 0;       // 質項 ZDD 的節點數
+    size_t peakNodes = 0;        // 結束時節點表的大小
+};
+
+// 挑出覆蓋 on 的 upper 的質項 (on <= upper)：每次取一個尚未覆蓋的 minterm，
+// 從 upper 的質項 ZDD 中選包含它且字母最少的質項，最後由後往前拿掉多餘的項
+// 質項 ZDD 超出步數預算 (質項多到連隱式表示都很大) 時改為逐一放寬 minterm 的變數得到質項
+// 結果為不可省略的質項覆蓋，但不保證最少項數
+CubeList BddCover(BddManager& mgr, BddRef on, BddRef upper, BddStats* stats = nullptr);
+
+// 由乘積項描述的函數 (1–32 變數，例如 PLA)
+CubeList SolveBdd(int numVars, const CubeList& onSet, const CubeList& dcSet, BddStats* stats = nullptr);
+
+#endif // BDD_H
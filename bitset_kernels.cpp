@@ -0,0 +1,275 @@
+#include "bitset_kernels.h"
+#include "bit_utils.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BITSET_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define KERNEL_TARGET(isa)
+#else
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+struct BitsetKernels {
+    BitsetLevel level;
+    int (*count)(const uint64_t* a, size_t n);
+    int (*countAnd)(const uint64_t* a, const uint64_t* b, size_t n);
+    bool (*subsetWithin)(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n);
+    bool (*intersect)(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n);
+    void (*andNot)(uint64_t* a, const uint64_t* b, size_t n);
+};
+
+// --- 純量版本 ---
+static int CountScalar(const uint64_t* a, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) count += PopCount64(a[i]);
+    return count;
+}
+
+static int CountAndScalar(const uint64_t* a, const uint64_t* b, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) count += PopCount64(a[i] & b[i]);
+    return count;
+}
+
+// 一個字就能決定結果，找到就提早結束 (支配判斷大多在前幾個字就失敗)
+static bool SubsetWithinScalar(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    for (size_t i = 0; i < n; i++) if (a[i] & mask[i] & ~b[i]) return false;
+    return true;
+}
+
+static bool IntersectScalar(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    for (size_t i = 0; i < n; i++) if (a[i] & b[i] & mask[i]) return true;
+    return false;
+}
+
+static void AndNotScalar(uint64_t* a, const uint64_t* b, size_t n) {
+    for (size_t i = 0; i < n; i++) a[i] &= ~b[i];
+}
+
+static const BitsetKernels SCALAR_KERNELS = {
+    BitsetLevel::Scalar, CountScalar, CountAndScalar, SubsetWithinScalar, IntersectScalar, AndNotScalar
+};
+
+#ifdef BITSET_X86
+// --- SSE4.2：一次 2 個字，popcount 用硬體指令 ---
+KERNEL_TARGET("sse4.2,popcnt")
+static int CountSse(const uint64_t* a, size_t n) {
+    long long count = 0;
+    for (size_t i = 0; i < n; i++) count += _mm_popcnt_u64(a[i]);
+    return (int)count;
+}
+
+KERNEL_TARGET("sse4.2,popcnt")
+static int CountAndSse(const uint64_t* a, const uint64_t* b, size_t n) {
+    long long count = 0;
+    for (size_t i = 0; i < n; i++) count += _mm_popcnt_u64(a[i] & b[i]);
+    return (int)count;
+}
+
+KERNEL_TARGET("sse4.2,popcnt")
+static bool SubsetWithinSse(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    __m128i diff = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        __m128i vm = _mm_loadu_si128((const __m128i*)(mask + i));
+        diff = _mm_or_si128(diff, _mm_andnot_si128(vb, _mm_and_si128(va, vm)));
+    }
+    uint64_t tail = 0;
+    for (; i < n; i++) tail |= a[i] & mask[i] & ~b[i];
+    return _mm_testz_si128(diff, diff) && tail == 0;
+}
+
+KERNEL_TARGET("sse4.2,popcnt")
+static bool IntersectSse(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    __m128i common = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        __m128i vm = _mm_loadu_si128((const __m128i*)(mask + i));
+        common = _mm_or_si128(common, _mm_and_si128(_mm_and_si128(va, vb), vm));
+    }
+    uint64_t tail = 0;
+    for (; i < n; i++) tail |= a[i] & b[i] & mask[i];
+    return !_mm_testz_si128(common, common) || tail != 0;
+}
+
+KERNEL_TARGET("sse4.2,popcnt")
+static void AndNotSse(uint64_t* a, const uint64_t* b, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        _mm_storeu_si128((__m128i*)(a + i), _mm_andnot_si128(vb, va));
+    }
+    for (; i < n; i++) a[i] &= ~b[i];
+}
+
+static const BitsetKernels SSE42_KERNELS = {
+    BitsetLevel::Sse42, CountSse, CountAndSse, SubsetWithinSse, IntersectSse, AndNotSse
+};
+
+// --- AVX2：一次 4 個字，popcount 用 4 位元查表 (vpshufb) 再以 vpsadbw 累加 ---
+KERNEL_TARGET("avx2,popcnt")
+static inline __m256i PopCountBytes256(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+    __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+KERNEL_TARGET("avx2,popcnt")
+static int HorizontalSum256(__m256i acc) {
+    return (int)(_mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+                 _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3));
+}
+
+KERNEL_TARGET("avx2,popcnt")
+static int CountAvx2(const uint64_t* a, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm256_add_epi64(acc, PopCountBytes256(_mm256_loadu_si256((const __m256i*)(a + i))));
+    long long count = HorizontalSum256(acc);
+    for (; i < n; i++) count += _mm_popcnt_u64(a[i]);
+    return (int)count;
+}
+
+KERNEL_TARGET("avx2,popcnt")
+static int CountAndAvx2(const uint64_t* a, const uint64_t* b, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        acc = _mm256_add_epi64(acc, PopCountBytes256(_mm256_and_si256(va, vb)));
+    }
+    long long count = HorizontalSum256(acc);
+    for (; i < n; i++) count += _mm_popcnt_u64(a[i] & b[i]);
+    return (int)count;
+}
+
+KERNEL_TARGET("avx2,popcnt")
+static bool SubsetWithinAvx2(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    __m256i diff = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i vm = _mm256_loadu_si256((const __m256i*)(mask + i));
+        diff = _mm256_or_si256(diff, _mm256_andnot_si256(vb, _mm256_and_si256(va, vm)));
+    }
+    uint64_t tail = 0;
+    for (; i < n; i++) tail |= a[i] & mask[i] & ~b[i];
+    return _mm256_testz_si256(diff, diff) && tail == 0;
+}
+
+KERNEL_TARGET("avx2,popcnt")
+static bool IntersectAvx2(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    __m256i common = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i vm = _mm256_loadu_si256((const __m256i*)(mask + i));
+        common = _mm256_or_si256(common, _mm256_and_si256(_mm256_and_si256(va, vb), vm));
+    }
+    uint64_t tail = 0;
+    for (; i < n; i++) tail |= a[i] & b[i] & mask[i];
+    return !_mm256_testz_si256(common, common) || tail != 0;
+}
+
+KERNEL_TARGET("avx2,popcnt")
+static void AndNotAvx2(uint64_t* a, const uint64_t* b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(a + i), _mm256_andnot_si256(vb, va));
+    }
+    for (; i < n; i++) a[i] &= ~b[i];
+}
+
+static const BitsetKernels AVX2_KERNELS = {
+    BitsetLevel::Avx2, CountAvx2, CountAndAvx2, SubsetWithinAvx2, IntersectAvx2, AndNotAvx2
+};
+
+// --- CPU 偵測 ---
+static bool CpuSupports(BitsetLevel level) {
+    if (level == BitsetLevel::Scalar) return true;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool popcnt = (info[2] >> 23) & 1;
+    bool sse42 = (info[2] >> 20) & 1;
+    if (level == BitsetLevel::Sse42) return popcnt && sse42;
+    // AVX 需要作業系統有保存 YMM 暫存器 (OSXSAVE + XCR0)
+    bool osxsave = (info[2] >> 27) & 1;
+    bool avx = (info[2] >> 28) & 1;
+    if (!popcnt || !osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 5) & 1;
+#else
+    __builtin_cpu_init();
+    if (level == BitsetLevel::Sse42) return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#endif
+}
+#else
+static bool CpuSupports(BitsetLevel level) { return level == BitsetLevel::Scalar; }
+#endif
+
+static const BitsetKernels* KernelsFor(BitsetLevel level) {
+#ifdef BITSET_X86
+    if (level == BitsetLevel::Avx2) return &AVX2_KERNELS;
+    if (level == BitsetLevel::Sse42) return &SSE42_KERNELS;
+#endif
+    (void)level;
+    return &SCALAR_KERNELS;
+}
+
+static const BitsetKernels*& ActiveKernels() {
+    static const BitsetKernels* active = [] {
+        if (CpuSupports(BitsetLevel::Avx2)) return KernelsFor(BitsetLevel::Avx2);
+        if (CpuSupports(BitsetLevel::Sse42)) return KernelsFor(BitsetLevel::Sse42);
+        return KernelsFor(BitsetLevel::Scalar);
+    }();
+    return active;
+}
+
+BitsetLevel GetBitsetLevel() { return ActiveKernels()->level; }
+
+bool bitsetVectorized = GetBitsetLevel() != BitsetLevel::Scalar;
+
+const char* BitsetLevelName(BitsetLevel level) {
+    switch (level) {
+        case BitsetLevel::Avx2: return "AVX2";
+        case BitsetLevel::Sse42: return "SSE4.2";
+        default: return "Scalar";
+    }
+}
+
+bool SetBitsetLevel(BitsetLevel level) {
+    if (!CpuSupports(level)) return false;
+    ActiveKernels() = KernelsFor(level);
+    bitsetVectorized = level != BitsetLevel::Scalar;
+    return true;
+}
+
+// --- 對外介面 ---
+int BitsCount(const uint64_t* a, size_t n) { return ActiveKernels()->count(a, n); }
+int BitsCountAnd(const uint64_t* a, const uint64_t* b, size_t n) { return ActiveKernels()->countAnd(a, b, n); }
+bool BitsSubsetWithin(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    return ActiveKernels()->subsetWithin(a, b, mask, n);
+}
+bool BitsIntersect(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    return ActiveKernels()->intersect(a, b, mask, n);
+}
+void BitsAndNot(uint64_t* a, const uint64_t* b, size_t n) { ActiveKernels()->andNot(a, b, n); }
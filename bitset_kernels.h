@@ -0,0 +1,37 @@
+// 位元陣列核心運算 (AND / ANDNOT / popcount)，執行期依 CPU 選擇 AVX2、SSE4.2 或純量版本
+#ifndef BITSET_KERNELS_H
+#define BITSET_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+enum class BitsetLevel {
+    Scalar, // 可攜版本
+    Sse42,  // 128 位元邏輯運算 + 硬體 popcnt
+    Avx2    // 256 位元邏輯運算 + vpshufb popcount
+};
+
+// 目前使用的版本 (第一次呼叫時偵測 CPU)
+BitsetLevel GetBitsetLevel();
+const char* BitsetLevelName(BitsetLevel level);
+
+// 強制指定版本 (測試 / 效能比較用)，CPU 不支援時回傳 false 且不變更
+bool SetBitsetLevel(BitsetLevel level);
+
+// 少於這個字數時經由函式指標呼叫的成本比向量化省下的多，呼叫端應直接用純量迴圈
+const size_t BITSET_KERNEL_MIN_WORDS = 4;
+
+// 目前的版本是否向量化 (啟動時依 CPU 設定，之後只有 SetBitsetLevel 會改變)
+extern bool bitsetVectorized;
+
+// 長度 n 的運算是否該交給核心：純量版本一律不必 (呼叫端自己的迴圈可以內聯，提早結束也不受函式指標阻隔)
+inline bool UseBitsetKernels(size_t n) { return bitsetVectorized && n >= BITSET_KERNEL_MIN_WORDS; }
+
+// --- 核心運算：n 為 64 位元字數 ---
+int BitsCount(const uint64_t* a, size_t n);                                          // popcount(a)
+int BitsCountAnd(const uint64_t* a, const uint64_t* b, size_t n);                    // popcount(a & b)
+bool BitsSubsetWithin(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n); // (a & mask) ⊆ b
+bool BitsIntersect(const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n);    // (a & b & mask) ≠ 0
+void BitsAndNot(uint64_t* a, const uint64_t* b, size_t n);                            // a &= ~b
+
+#endif // BITSET_KERNELS_H
@@ -0,0 +1,82 @@
+#include "consensus.h"
+#include <algorithm>
+
+// 目前的項 (彼此沒有包含關係)；被新項吃掉的只標記為失效，索引維持不變
+struct ConsensusSet {
+    CubeList cubes;
+    std::vector<char> alive;
+    std::vector<int> pending; // 尚未與其他項取 consensus 的項
+
+    void Add(Cube c) {
+        for (size_t i = 0; i < cubes.size(); i++) {
+            if (alive[i] && CubeContains(cubes[i], c)) return;
+        }
+        for (size_t i = 0; i < cubes.size(); i++) {
+            if (alive[i] && CubeContains(c, cubes[i])) alive[i] = 0;
+        }
+        cubes.push_back(c);
+        alive.push_back(1);
+        pending.push_back((int)cubes.size() - 1);
+    }
+};
+
+CubeList ConsensusPrimes(int numVars, const CubeList& onSet, const CubeList& dcSet) {
+    CubeList primes;
+    if (numVars < 1 || numVars > CONSENSUS_MAX_VARS) return primes;
+
+    ConsensusSet set;
+    for (const CubeList* list : { &onSet, &dcSet }) {
+        for (Cube c : *list) {
+            c = CubeNormalize(c, numVars);
+            if (!CubeIsEmpty(c)) set.Add(c);
+        }
+    }
+
+    // 先進先出：每一項在輪到它時與當時所有有效的項各取一次 consensus
+    for (size_t next = 0; next < set.pending.size(); next++) {
+        const int i = set.pending[next];
+        for (size_t j = 0; j < set.cubes.size() && set.alive[i]; j++) {
+            if (!set.alive[j] || (int)j == i) continue;
+            uint64_t conflict = CubeEmptyFields(set.cubes[i] & set.cubes[j]);
+            if (conflict == 0 || (conflict & (conflict - 1)) != 0) continue;
+            set.Add(CubeConsensus(set.cubes[i], set.cubes[j]));
+        }
+    }
+
+    for (size_t i = 0; i < set.cubes.size(); i++) {
+        if (!set.alive[i]) continue;
+        for (Cube c : onSet) {
+            if (CubesIntersect(set.cubes[i], CubeNormalize(c, numVars))) { primes.push_back(set.cubes[i]); break; }
+        }
+    }
+    return primes;
+}
+
+QMResult SolveConsensus(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet,
+                        const CoverOptions& opts) {
+    QMResult result;
+    result.stats.optimal = true;
+    if (numVars < 1 || numVars > CONSENSUS_MAX_VARS) return result;
+    const uint32_t varMask = numVars == 32 ? ~0u : (1u << numVars) - 1;
+
+    std::vector<uint32_t> rows;
+    for (uint32_t m : onSet) if ((m & ~varMask) == 0) rows.push_back(m);
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if (rows.empty()) return result;
+
+    CubeList on, dc;
+    for (uint32_t m : rows) on.push_back(CubeFromImplicant({ m, 0 }, numVars));
+    for (uint32_t m : dcSet) if ((m & ~varMask) == 0) dc.push_back(CubeFromImplicant({ m, 0 }, numVars));
+    for (Cube c : ConsensusPrimes(numVars, on, dc)) result.primes.push_back(CubeToImplicant(c, numVars));
+
+    CoverProblem chart;
+    chart.Init((int)rows.size(), (int)result.primes.size());
+    for (size_t c = 0; c < result.primes.size(); c++) {
+        for (size_t r = 0; r < rows.size(); r++) if (result.primes[c].Covers(rows[r])) chart.Set((int)c, (int)r);
+    }
+
+    result.stats = SolveCover(chart, opts);
+    for (int c : result.stats.cols) result.cover.push_back(result.primes[c]);
+    return result;
+}
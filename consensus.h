@@ -0,0 +1,23 @@
+// 反覆 consensus (iterated consensus) 產生質項：從 on-set 與 Don't Care 的乘積項出發，
+// 距離為 1 的兩項取 consensus，被包含的項隨時移除，直到不再產生新的項為止 (結果即為全部質項)
+// 工作量取決於乘積項的數量，與 2^N 無關，適合大空間中只有少數指定 minterm 的函數
+// (指定的 minterm 很多時中間項數量會暴增，密集的函數仍應使用 SolveQM)
+#ifndef CONSENSUS_H
+#define CONSENSUS_H
+
+#include "cube.h"
+#include "qm.h"
+#include <cstdint>
+#include <vector>
+
+const int CONSENSUS_MAX_VARS = 32;
+
+// onSet ∪ dcSet 的全部質項中與 onSet 相交的部分 (依產生順序)
+CubeList ConsensusPrimes(int numVars, const CubeList& onSet, const CubeList& dcSet);
+
+// 與 SolveQM 相同的輸入與輸出 (1–32 變數，超出範圍的 minterm 會被忽略)
+// 質項表的列只有 on-set 的 minterm，不建立 2^N 大小的索引
+QMResult SolveConsensus(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet,
+                        const CoverOptions& opts = CoverOptions());
+
+#endif // CONSENSUS_H
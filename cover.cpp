@@ -0,0 +1,607 @@
+#include "cover.h"
+#include "bit_utils.h"
+#include "bitset_kernels.h"
+#include "sat_solver.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <mutex>
+
+// --- 位元陣列輔助 ---
+// 暫存的位元陣列都從 arena 切出，長度 (words) 由呼叫端記住
+static bool TestBit(const uint64_t* a, int i) { return (a[i / 64] >> (i % 64)) & 1; }
+static void ClearBit(uint64_t* a, int i) { a[i / 64] &= ~(1ull << (i % 64)); }
+
+static bool AnyBits(const uint64_t* a, int words) {
+    for (int i = 0; i < words; i++) if (a[i]) return true;
+    return false;
+}
+
+// 計數與包含判斷：向量化版本可用且位元陣列夠長時交給 bitset_kernels (AVX2 / SSE4.2，執行期選擇)，
+// 其餘 (純量版本、4 變數卡諾圖只有 1 個字的質項表) 直接在這裡算，省去經由函式指標的呼叫
+static int Count(const uint64_t* a, int n) {
+    if (UseBitsetKernels((size_t)n)) return BitsCount(a, (size_t)n);
+    int count = 0;
+    for (int i = 0; i < n; i++) count += PopCount64(a[i]);
+    return count;
+}
+
+static int CountAnd(const uint64_t* a, const uint64_t* b, int n) {
+    if (UseBitsetKernels((size_t)n)) return BitsCountAnd(a, b, (size_t)n);
+    int count = 0;
+    for (int i = 0; i < n; i++) count += PopCount64(a[i] & b[i]);
+    return count;
+}
+
+// (a & mask) 是否包含於 (b & mask)
+static bool SubsetWithin(const uint64_t* a, const uint64_t* b, const uint64_t* mask, int n) {
+    if (UseBitsetKernels((size_t)n)) return BitsSubsetWithin(a, b, mask, (size_t)n);
+    for (int i = 0; i < n; i++) if (a[i] & mask[i] & ~b[i]) return false;
+    return true;
+}
+
+// (a & b & mask) 不為空
+static bool Intersect(const uint64_t* a, const uint64_t* b, const uint64_t* mask, int n) {
+    if (UseBitsetKernels((size_t)n)) return BitsIntersect(a, b, mask, (size_t)n);
+    for (int i = 0; i < n; i++) if (a[i] & b[i] & mask[i]) return true;
+    return false;
+}
+
+static void AndNot(uint64_t* a, const uint64_t* b, int n) {
+    if (UseBitsetKernels((size_t)n)) BitsAndNot(a, b, (size_t)n);
+    else for (int i = 0; i < n; i++) a[i] &= ~b[i];
+}
+
+// 依序走訪所有被設定的位元 (走訪中修改 a 只影響之後的 word)
+template <typename F>
+static void ForEachBit(const uint64_t* a, int words, F f) {
+    for (int i = 0; i < words; i++) {
+        uint64_t w = a[i];
+        while (w) {
+            f(i * 64 + CountTrailingZeros64(w));
+            w &= w - 1;
+        }
+    }
+}
+
+static uint64_t* AllBits(Arena& arena, int n) {
+    int words = (n + 63) / 64;
+    uint64_t* a = arena.Alloc<uint64_t>((size_t)words);
+    for (int i = 0; i < words; i++) a[i] = ~0ull;
+    if (n % 64) a[words - 1] = (1ull << (n % 64)) - 1;
+    return a;
+}
+
+// std::pair 不是 trivially copyable，排序與 heap 用的 (分數, 索引) 改用這個
+struct IntPair {
+    int first, second;
+    bool operator<(const IntPair& o) const { return first < o.first || (first == o.first && second < o.second); }
+};
+
+// --- 貪婪法 ---
+static void GreedyCover(const CoverProblem& p, const uint64_t* rowCols, int colWords, Arena& arena, CoverResult& res) {
+    ArenaScope scope(arena);
+    uint64_t* uncovered = AllBits(arena, p.numRows);
+    uint8_t* used = arena.AllocZeroed<uint8_t>((size_t)p.numCols);
+
+    // 必要質項：只有一個質項能覆蓋的列
+    for (int r = 0; r < p.numRows; r++) {
+        const uint64_t* cols = &rowCols[(size_t)r * colWords];
+        // 看到第二個質項就停
+        int coverCount = 0, unique = -1;
+        for (int w = 0; w < colWords && coverCount < 2; w++) {
+            coverCount += PopCount64(cols[w]);
+            if (cols[w]) unique = w * 64 + CountTrailingZeros64(cols[w]);
+        }
+        if (coverCount == 1 && !used[unique]) {
+            used[unique] = 1;
+            res.cols.push_back(unique);
+            res.cost += p.Cost(unique);
+            AndNot(uncovered, p.Col(unique), p.rowWords);
+        }
+    }
+
+    // 覆蓋數只會減少，用 lazy 優先佇列：取出的分數過期就重算後放回
+    // 排序為 (覆蓋數 / 成本大, 索引小)，結果與逐一掃描所有質項相同；單位成本時即為 (覆蓋數大, 索引小)
+    auto lower = [&p](const IntPair& a, const IntPair& b) {
+        int64_t lhs = (int64_t)a.first * p.Cost(-b.second), rhs = (int64_t)b.first * p.Cost(-a.second);
+        return lhs != rhs ? lhs < rhs : a.second < b.second;
+    };
+    IntPair* heap = arena.Alloc<IntPair>((size_t)p.numCols);
+    IntPair* heapEnd = heap;
+    for (int c = 0; c < p.numCols; c++) {
+        if (used[c]) continue;
+        int gain = CountAnd(p.Col(c), uncovered, p.rowWords);
+        if (gain > 0) *heapEnd++ = { gain, -c };
+    }
+    std::make_heap(heap, heapEnd, lower);
+    while (AnyBits(uncovered, p.rowWords)) {
+        if (heap == heapEnd) { res.complete = false; break; }
+        std::pop_heap(heap, heapEnd, lower);
+        IntPair top = *--heapEnd;
+        int c = -top.second;
+        int gain = CountAnd(p.Col(c), uncovered, p.rowWords);
+        if (gain != top.first) {
+            if (gain > 0) { *heapEnd++ = { gain, -c }; std::push_heap(heap, heapEnd, lower); }
+            continue;
+        }
+        used[c] = 1;
+        res.cols.push_back(c);
+        res.cost += p.Cost(c);
+        AndNot(uncovered, p.Col(c), p.rowWords);
+    }
+}
+
+// --- 精確法 (分支界限) ---
+const int COVER_PARALLEL_MIN_ROWS = 48; // 列數少於此時序列搜尋較快
+const int COVER_SPLIT_DEPTH = 2;        // 平行時在前兩層分支切成子樹工作
+
+// 切出來的子樹：進入該節點時的列 / 行集合與已選的質項
+struct SubtreeTask {
+    std::vector<uint64_t> rows, cols;
+    std::vector<int> chosen;
+    int cost;
+};
+
+// 平行搜尋共用的狀態
+// 最佳解以 (成本, 子樹編號) 的字典序比較 (初始的貪婪解編號為 -1)：子樹依序列搜尋的順序編號，
+// 各子樹內找到的又是搜尋順序中第一個最低成本解，因此結果與序列搜尋完全相同
+struct SharedSearch {
+    std::atomic<int64_t> bestKey{0}; // (cost << 32) | (task + 1)，只在持有 lock 時寫入
+    std::mutex lock;
+    std::vector<int> bestCols;
+    std::atomic<uint64_t> nodes{0};
+    std::atomic<bool> aborted{false};
+};
+
+static int64_t SearchKey(int cost, int task) { return ((int64_t)cost << 32) | (int64_t)(task + 1); }
+
+// 每一層的列 / 行集合與暫存陣列都從 arena 切出，回到上一層時整批歸還
+class ExactCover {
+public:
+    ExactCover(const CoverProblem& p, const uint64_t* rowCols, int colWords, const CoverOptions& opts, Arena& arena)
+        : p(p), rowCols(rowCols), colWords(colWords), opts(opts), arena(arena), start(std::chrono::steady_clock::now()) {}
+
+    // res.cols 為初始解 (貪婪法)，搜尋後換成找到的最佳解
+    void Run(CoverResult& res) {
+        ArenaScope scope(arena);
+        best = arena.Alloc<int>((size_t)p.numCols);
+        chosen = arena.Alloc<int>((size_t)p.numCols);
+        bestCount = res.cols.size();
+        bestCost = res.cost;
+        std::copy(res.cols.begin(), res.cols.end(), best);
+        chosenCount = 0;
+        chosenCost = 0;
+        uint64_t* rows = AllBits(arena, p.numRows);
+        uint64_t* cols = AllBits(arena, p.numCols);
+        if (opts.parallel && p.numRows >= COVER_PARALLEL_MIN_ROWS) RunParallel(rows, cols);
+        else Search(rows, cols);
+        res.cols.assign(best, best + bestCount);
+        res.cost = bestCost;
+        res.optimal = !aborted;
+        res.nodes = nodes;
+    }
+
+private:
+    const CoverProblem& p;
+    const uint64_t* rowCols;
+    int colWords;
+    CoverOptions opts;
+    Arena& arena;
+    std::chrono::steady_clock::time_point start;
+    int* best = nullptr;
+    size_t bestCount = 0;
+    int bestCost = 0;
+    int* chosen = nullptr;
+    size_t chosenCount = 0;
+    int chosenCost = 0;
+    uint64_t nodes = 0;
+    bool aborted = false;
+
+    int level = 0;                          // 目前的分支深度
+    std::vector<SubtreeTask>* split = nullptr; // 不為 nullptr 時只搜尋到 COVER_SPLIT_DEPTH 層，子樹存進這裡
+    SharedSearch* shared = nullptr;         // 平行搜尋的子樹工作
+    int taskIndex = 0;
+
+    // 循環核心先在前幾層切成子樹 (依序列搜尋的順序)，再交給執行緒池；各子樹以共用的最佳成本剪枝
+    void RunParallel(uint64_t* rows, uint64_t* cols) {
+        std::vector<SubtreeTask> tasks;
+        split = &tasks;
+        Search(rows, cols);
+        split = nullptr;
+        if (aborted || tasks.empty()) return;
+
+        SharedSearch s;
+        s.bestKey = SearchKey(bestCost, -1);
+        s.bestCols.assign(best, best + bestCount);
+        s.nodes = nodes;
+        ThreadPool::Shared().ParallelFor(tasks.size(), [&](size_t i) {
+            if (s.aborted.load(std::memory_order_relaxed)) return;
+            Arena taskArena;
+            ExactCover sub(p, rowCols, colWords, opts, taskArena);
+            sub.start = start;
+            sub.RunTask(tasks[i], s, (int)i);
+        });
+
+        bestCount = s.bestCols.size();
+        std::copy(s.bestCols.begin(), s.bestCols.end(), best);
+        bestCost = (int)(s.bestKey.load() >> 32);
+        nodes = s.nodes;
+        aborted = s.aborted;
+    }
+
+    void RunTask(const SubtreeTask& task, SharedSearch& s, int index) {
+        ArenaScope scope(arena);
+        shared = &s;
+        taskIndex = index;
+        best = arena.Alloc<int>((size_t)p.numCols);
+        chosen = arena.Alloc<int>((size_t)p.numCols);
+        bestCount = 0;
+        bestCost = INT_MAX;
+        std::copy(task.chosen.begin(), task.chosen.end(), chosen);
+        chosenCount = task.chosen.size();
+        chosenCost = task.cost;
+        level = COVER_SPLIT_DEPTH;
+        Search(arena.AllocCopy(task.rows.data(), task.rows.size()), arena.AllocCopy(task.cols.data(), task.cols.size()));
+    }
+
+    void Emit(const uint64_t* rows, const uint64_t* cols) {
+        split->push_back({ std::vector<uint64_t>(rows, rows + p.rowWords), std::vector<uint64_t>(cols, cols + colWords),
+                           std::vector<int>(chosen, chosen + chosenCount), chosenCost });
+    }
+
+    // 剪枝門檻：成本達到此值的部分解不必再搜尋
+    // 共用的最佳解來自較前面的子樹 (或貪婪解) 時同成本也剪掉，來自較後面的子樹時同成本仍要找 (這裡的解優先)
+    int Limit() const {
+        if (!shared) return bestCost;
+        int64_t key = shared->bestKey.load(std::memory_order_relaxed);
+        int cost = (int)(key >> 32), owner = (int)(key & 0xFFFFFFFF) - 1;
+        return std::min(bestCost, owner < taskIndex ? cost : cost + 1);
+    }
+
+    void Record() {
+        std::copy(chosen, chosen + chosenCount, best);
+        bestCount = chosenCount;
+        bestCost = chosenCost;
+        if (!shared) return;
+        std::lock_guard<std::mutex> guard(shared->lock);
+        int64_t key = SearchKey(chosenCost, taskIndex);
+        if (key < shared->bestKey.load(std::memory_order_relaxed)) {
+            shared->bestCols.assign(chosen, chosen + chosenCount);
+            shared->bestKey = key;
+        }
+    }
+
+    void Abort() {
+        aborted = true;
+        if (shared) shared->aborted = true;
+    }
+
+    const uint64_t* RowCols(int r) const { return &rowCols[(size_t)r * colWords]; }
+
+    // colSet 中 (限定 cols) 覆蓋列數最少的質項，沒有則回傳 -1
+    int SparsestCol(const uint64_t* colSet, const uint64_t* cols) const {
+        int best = -1, bestCount = 0;
+        for (int w = 0; w < colWords; w++) {
+            uint64_t m = colSet[w] & cols[w];
+            while (m) {
+                int c = w * 64 + CountTrailingZeros64(m);
+                m &= m - 1;
+                int count = Count(p.Col(c), p.rowWords);
+                if (best < 0 || count < bestCount) { best = c; bestCount = count; }
+            }
+        }
+        return best;
+    }
+
+    // 質項 colSet 覆蓋的列 (限定 rows) 中可選質項最少的列，沒有則回傳 -1
+    int SparsestRow(const uint64_t* rowSet, const uint64_t* rows, const uint64_t* cols) const {
+        int best = -1, bestCount = 0;
+        for (int w = 0; w < p.rowWords; w++) {
+            uint64_t m = rowSet[w] & rows[w];
+            while (m) {
+                int r = w * 64 + CountTrailingZeros64(m);
+                m &= m - 1;
+                int count = CountAnd(RowCols(r), cols, colWords);
+                if (best < 0 || count < bestCount) { best = r; bestCount = count; }
+            }
+        }
+        return best;
+    }
+
+    bool OutOfBudget() {
+        if (shared && shared->aborted.load(std::memory_order_relaxed)) return true;
+        uint64_t total = shared ? shared->nodes.load(std::memory_order_relaxed) : nodes;
+        if (opts.nodeLimit && total > opts.nodeLimit) return true;
+        if (opts.cancel && opts.cancel->load(std::memory_order_relaxed)) return true;
+        if (opts.timeLimitMs > 0) {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (ms > opts.timeLimitMs) return true;
+        }
+        return false;
+    }
+
+    // colSet 中 (限定 cols) 最低的質項成本
+    int MinCost(const uint64_t* colSet, const uint64_t* cols) const {
+        if (p.colCost.empty()) return 1;
+        int best = 0;
+        for (int w = 0; w < colWords; w++) {
+            for (uint64_t m = colSet[w] & cols[w]; m; m &= m - 1) {
+                int cost = p.Cost(w * 64 + CountTrailingZeros64(m));
+                if (best == 0 || cost < best) best = cost;
+            }
+        }
+        return best;
+    }
+
+    void Take(int c, uint64_t* rows, uint64_t* cols) {
+        chosen[chosenCount++] = c;
+        chosenCost += p.Cost(c);
+        AndNot(rows, p.Col(c), p.rowWords);
+        ClearBit(cols, c);
+    }
+
+    // 必要質項、列支配、行支配，反覆化簡到穩定；回傳 false 表示無解
+    bool Reduce(uint64_t* rows, uint64_t* cols) {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+
+            bool feasible = true;
+            ForEachBit(rows, p.rowWords, [&](int r) {
+                if (!feasible || !TestBit(rows, r)) return;
+                int count = CountAnd(RowCols(r), cols, colWords);
+                if (count == 0) { feasible = false; return; }
+                if (count == 1) {
+                    int only = -1;
+                    for (int w = 0; w < colWords; w++) {
+                        uint64_t m = RowCols(r)[w] & cols[w];
+                        if (m) { only = w * 64 + CountTrailingZeros64(m); break; }
+                    }
+                    Take(only, rows, cols);
+                    changed = true;
+                }
+            });
+            if (!feasible) return false;
+            if (chosenCost >= Limit()) return true;
+
+            ArenaScope scope(arena);
+
+            // 列支配：覆蓋 r2 的質項都能覆蓋 r1 時，r1 可以忽略
+            // r1 必定也被 r2 最稀疏的那個質項覆蓋，只需檢查該質項的列
+            int* live = arena.Alloc<int>((size_t)p.numRows);
+            int liveCount = 0;
+            ForEachBit(rows, p.rowWords, [&](int r) { live[liveCount++] = r; });
+            for (int i = 0; i < liveCount; i++) {
+                int r2 = live[i];
+                if (!TestBit(rows, r2)) continue;
+                if (OutOfBudget()) { Abort(); return true; }
+                int pivot = SparsestCol(RowCols(r2), cols);
+                if (pivot < 0) continue;
+                ForEachBit(p.Col(pivot), p.rowWords, [&](int r1) {
+                    if (r1 == r2 || !TestBit(rows, r1) || !TestBit(rows, r2)) return;
+                    if (!SubsetWithin(RowCols(r2), RowCols(r1), cols, colWords)) return;
+                    if (SubsetWithin(RowCols(r1), RowCols(r2), cols, colWords) && r1 < r2) return;
+                    ClearBit(rows, r1);
+                    changed = true;
+                });
+            }
+
+            // 行支配：c2 覆蓋的列都被 c1 覆蓋且 c1 成本不高於 c2 時，c2 可以移除 (也移除不再有用的行)
+            // c1 必定覆蓋 c2 中可選質項最少的那一列，只需檢查該列的質項
+            int* liveCols = arena.Alloc<int>((size_t)p.numCols);
+            int liveColCount = 0;
+            ForEachBit(cols, colWords, [&](int c) { liveCols[liveColCount++] = c; });
+            for (int i = 0; i < liveColCount; i++) {
+                int c2 = liveCols[i];
+                if (OutOfBudget()) { Abort(); return true; }
+                int pivot = SparsestRow(p.Col(c2), rows, cols);
+                if (pivot < 0) { ClearBit(cols, c2); changed = true; continue; }
+                const uint64_t* candidates = RowCols(pivot);
+                for (int w = 0; w < colWords && TestBit(cols, c2); w++) {
+                    uint64_t m = candidates[w] & cols[w];
+                    while (m) {
+                        int c1 = w * 64 + CountTrailingZeros64(m);
+                        m &= m - 1;
+                        if (c1 == c2 || p.Cost(c1) > p.Cost(c2)) continue;
+                        if (!SubsetWithin(p.Col(c2), p.Col(c1), rows, p.rowWords)) continue;
+                        if (p.Cost(c1) == p.Cost(c2) && SubsetWithin(p.Col(c1), p.Col(c2), rows, p.rowWords) && c2 < c1) continue;
+                        ClearBit(cols, c2);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // 下界：彼此沒有共同質項的列，每一列都需要各自的質項 (至少付出能覆蓋它的質項中最低的成本)
+    int IndependentSetBound(const uint64_t* rows, const uint64_t* cols) {
+        ArenaScope scope(arena);
+        IntPair* order = arena.Alloc<IntPair>((size_t)p.numRows);
+        int orderCount = 0;
+        ForEachBit(rows, p.rowWords, [&](int r) { order[orderCount++] = { CountAnd(RowCols(r), cols, colWords), r }; });
+        std::sort(order, order + orderCount);
+        uint64_t* used = arena.AllocZeroed<uint64_t>((size_t)colWords);
+        int bound = 0;
+        for (int i = 0; i < orderCount; i++) {
+            const uint64_t* rc = RowCols(order[i].second);
+            if (Intersect(rc, used, cols, colWords)) continue;
+            for (int w = 0; w < colWords; w++) used[w] |= rc[w] & cols[w];
+            bound += MinCost(rc, cols);
+        }
+        return bound;
+    }
+
+    // rows / cols 由呼叫端配置，這一層可以直接修改
+    void Search(uint64_t* rows, uint64_t* cols) {
+        if (aborted) return;
+        if (split && level == COVER_SPLIT_DEPTH) { Emit(rows, cols); return; }
+        nodes++;
+        if (shared) shared->nodes.fetch_add(1, std::memory_order_relaxed);
+        if (OutOfBudget()) { Abort(); return; }
+
+        size_t depth = chosenCount;
+        int depthCost = chosenCost;
+        if (Reduce(rows, cols)) {
+            if (!AnyBits(rows, p.rowWords)) {
+                // 切分階段找到的解也當成子樹，維持與序列搜尋相同的先後順序
+                if (split) Emit(rows, cols);
+                else if (chosenCost < Limit()) Record();
+            } else if (chosenCost + IndependentSetBound(rows, cols) < Limit()) {
+                // 分支：挑選可選質項最少的列，逐一嘗試覆蓋它的質項
+                int branchRow = -1, minCount = 0;
+                ForEachBit(rows, p.rowWords, [&](int r) {
+                    int count = CountAnd(RowCols(r), cols, colWords);
+                    if (branchRow < 0 || count < minCount) { branchRow = r; minCount = count; }
+                });
+                ArenaScope scope(arena);
+                IntPair* options = arena.Alloc<IntPair>((size_t)minCount);
+                int optionCount = 0;
+                for (int w = 0; w < colWords; w++) {
+                    uint64_t m = RowCols(branchRow)[w] & cols[w];
+                    while (m) {
+                        int c = w * 64 + CountTrailingZeros64(m);
+                        options[optionCount++] = { -CountAnd(p.Col(c), rows, p.rowWords), c };
+                        m &= m - 1;
+                    }
+                }
+                std::sort(options, options + optionCount);
+                for (int i = 0; i < optionCount; i++) {
+                    ArenaScope branch(arena);
+                    uint64_t* nextRows = arena.AllocCopy(rows, (size_t)p.rowWords);
+                    uint64_t* nextCols = arena.AllocCopy(cols, (size_t)colWords);
+                    size_t mark = chosenCount;
+                    int markCost = chosenCost;
+                    Take(options[i].second, nextRows, nextCols);
+                    level++;
+                    Search(nextRows, nextCols);
+                    level--;
+                    chosenCount = mark;
+                    chosenCost = markCost;
+                    // 之後的分支不再考慮這個質項，避免重複搜尋同一組解
+                    ClearBit(cols, options[i].second);
+                    if (aborted) break;
+                }
+            }
+        }
+        chosenCount = depth;
+        chosenCost = depthCost;
+    }
+};
+
+// --- SAT (CDCL) ---
+// 變數 x_c = 選第 c 個質項，每一列一個子句 (能覆蓋它的質項至少選一個)
+// 成本以加權順序計數器編碼：s[i][j] = 前 i 個質項的成本和 >= j (1 <= j <= K，超過 K 時停在 K)，K 為初始解的成本
+// 每找到成本 c 的解就加入 ¬s[n][c] 要求更便宜的解 (學到的子句保留)，Unsat 即證明目前的解最低
+// 求解器每個執行緒一個並重複使用 (Reset 保留容量)，其餘暫存陣列從 arena 切出
+static void SatCover(const CoverProblem& p, const uint64_t* rowCols, int colWords, const CoverOptions& opts,
+                     Arena& arena, CoverResult& res) {
+    static thread_local SatSolver solver;
+    ArenaScope scope(arena);
+    const int bound = res.cost;
+    const auto start = std::chrono::steady_clock::now();
+    solver.Reset();
+    int* x = arena.Alloc<int>((size_t)p.numCols);
+    for (int c = 0; c < p.numCols; c++) x[c] = AnyBits(p.Col(c), p.rowWords) ? solver.NewVar() : -1;
+    SatLit* clause = arena.Alloc<SatLit>((size_t)p.numCols);
+    for (int r = 0; r < p.numRows; r++) {
+        size_t count = 0;
+        const uint64_t* cols = rowCols + (size_t)r * colWords;
+        for (int w = 0; w < colWords; w++) {
+            for (uint64_t m = cols[w]; m; m &= m - 1) clause[count++] = MakeLit(x[w * 64 + CountTrailingZeros64(m)]);
+        }
+        solver.AddClause(clause, count);
+    }
+
+    // sum[j - 1] = 目前為止成本和 >= j 的變數 (-1 = 還不可能)
+    int* sum = arena.Alloc<int>((size_t)bound);
+    int* next = arena.Alloc<int>((size_t)bound);
+    std::fill(sum, sum + bound, -1);
+    for (int c = 0; c < p.numCols; c++) {
+        if (x[c] < 0) continue;
+        const SatLit take = MakeLit(x[c]);
+        const int w = std::min(p.Cost(c), bound);
+        for (int j = 0; j < bound; j++) {
+            next[j] = (sum[j] >= 0 || j < w || sum[j - w] >= 0) ? solver.NewVar() : -1;
+            if (next[j] < 0) continue;
+            if (sum[j] >= 0) solver.AddClause({ MakeLit(sum[j], true), MakeLit(next[j]) });
+            if (j < w) solver.AddClause({ NegLit(take), MakeLit(next[j]) });
+            else if (sum[j - w] >= 0) solver.AddClause({ NegLit(take), MakeLit(sum[j - w], true), MakeLit(next[j]) });
+        }
+        std::swap(sum, next);
+    }
+
+    auto stop = [&]() {
+        if (opts.cancel && opts.cancel->load(std::memory_order_relaxed)) return true;
+        if (opts.timeLimitMs <= 0) return false;
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() > opts.timeLimitMs;
+    };
+    res.optimal = false;
+    for (int k = bound;;) {
+        // 要求成本 < k (目前的解成本為 k，s[n][k] 必定存在)；k 為 0 或頂層就矛盾時已是最低
+        if (k == 0 || !solver.AddClause({ MakeLit(sum[k - 1], true) })) {
+            res.optimal = true;
+            break;
+        }
+        uint64_t budget = 0;
+        if (opts.conflictLimit) {
+            if (solver.Conflicts() >= opts.conflictLimit) break;
+            budget = opts.conflictLimit - solver.Conflicts();
+        }
+        const SatStatus status = solver.Solve(budget, stop);
+        if (status == SatStatus::Unsat) res.optimal = true;
+        if (status != SatStatus::Sat) break;
+        res.cols.clear();
+        res.cost = 0;
+        for (int c = 0; c < p.numCols; c++) {
+            if (x[c] >= 0 && solver.Value(x[c])) {
+                res.cols.push_back(c);
+                res.cost += p.Cost(c);
+            }
+        }
+        k = res.cost;
+    }
+    res.nodes = solver.Conflicts();
+}
+
+void SolveCover(const CoverProblem& p, const CoverOptions& opts, Arena& arena, CoverResult& res) {
+    res.cols.clear();
+    res.cost = 0;
+    res.optimal = false;
+    res.complete = true;
+    res.nodes = 0;
+    ArenaScope scope(arena);
+
+    // 轉置：每一列可由哪些質項覆蓋
+    int colWords = (p.numCols + 63) / 64;
+    uint64_t* rowCols = arena.AllocZeroed<uint64_t>((size_t)p.numRows * colWords);
+    for (int c = 0; c < p.numCols; c++) {
+        const uint64_t* col = p.Col(c);
+        for (int w = 0; w < p.rowWords; w++) {
+            for (uint64_t m = col[w]; m; m &= m - 1) {
+                int r = w * 64 + CountTrailingZeros64(m);
+                rowCols[(size_t)r * colWords + c / 64] |= 1ull << (c % 64);
+            }
+        }
+    }
+
+    GreedyCover(p, rowCols, colWords, arena, res);
+    if (opts.method == CoverMethod::Greedy || !res.complete) return;
+    if (opts.method == CoverMethod::Sat) {
+        SatCover(p, rowCols, colWords, opts, arena, res);
+        return;
+    }
+
+    ExactCover search(p, rowCols, colWords, opts, arena);
+    search.Run(res);
+}
+
+CoverResult SolveCover(const CoverProblem& p, const CoverOptions& opts) {
+    static thread_local Arena arena;
+    CoverResult res;
+    SolveCover(p, opts, arena, res);
+    return res;
+}
@@ -0,0 +1,73 @@
+// 質項覆蓋 (set cover) 引擎：貪婪法、精確分支界限法與 SAT (CDCL) 精確解，可指定每個質項的成本 (weighted set cover)
+#ifndef COVER_H
+#define COVER_H
+
+#include "arena.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class CoverMethod {
+    Greedy, // 必要質項 + 每次挑 (新覆蓋數 / 成本) 最大的質項 (原本的做法)
+    Exact,  // 分支界限法，保證最低成本 (預算內)
+    Sat     // 內建 CDCL SAT：反覆問「是否有成本 <= k 的覆蓋」並逐步收緊 k，保證最低成本 (衝突預算內)
+};
+
+// 4 變數化簡用的成本模型：由化簡器換成每個質項的成本 (CoverProblem::SetCost)，覆蓋引擎本身只看成本
+enum class CostModel {
+    Terms,      // 每個質項成本 1 (最少項數，原本的做法)
+    Literals,   // 質項的字母數 (常數項算 1)
+    GateInputs  // 兩層 AND-OR 的閘輸入數：字母數 (多於一個時需要 AND 閘) + 1 個 OR 輸入
+};
+
+struct CoverOptions {
+    CoverMethod method = CoverMethod::Greedy;
+    uint64_t nodeLimit = 2000000; // 搜尋節點上限，0 = 不限
+    uint64_t conflictLimit = 200000; // SAT 的衝突上限 (所有 k 合計)，0 = 不限
+    double timeLimitMs = 0.0;     // 時間上限 (毫秒)，0 = 不限
+    bool parallel = true;         // 大型問題允許使用共用執行緒池
+    const std::atomic<bool>* cancel = nullptr; // 由其他執行緒設為 true 時中止精確搜尋 (回傳目前最佳解)
+    CostModel costModel = CostModel::Terms;
+};
+
+// 質項表：列 (row) = 需要被覆蓋的元素，行 (col) = 可選的質項
+// 每個質項的覆蓋集合以連續的位元陣列存放
+struct CoverProblem {
+    int numRows = 0;
+    int numCols = 0;
+    int rowWords = 0;
+    std::vector<uint64_t> colBits;
+    std::vector<int> colCost; // 每個質項的成本 (>= 1)，空的表示全部為 1
+
+    void Init(int rows, int cols) {
+        numRows = rows;
+        numCols = cols;
+        rowWords = (rows + 63) / 64;
+        colBits.assign((size_t)rowWords * cols, 0);
+        colCost.clear();
+    }
+    void Set(int col, int row) { colBits[(size_t)col * rowWords + row / 64] |= 1ull << (row % 64); }
+    void SetCost(int col, int cost) {
+        if (colCost.empty()) colCost.assign(numCols, 1);
+        colCost[col] = cost;
+    }
+    const uint64_t* Col(int col) const { return &colBits[(size_t)col * rowWords]; }
+    int Cost(int col) const { return colCost.empty() ? 1 : colCost[col]; }
+};
+
+struct CoverResult {
+    std::vector<int> cols;  // 選中的質項 (依選擇順序)
+    int cost = 0;           // 選中質項的成本總和 (單位成本時即為項數)
+    bool optimal = false;   // 已證明為最低成本
+    bool complete = true;   // 所有列皆被覆蓋 (質項表不足時為 false)
+    uint64_t nodes = 0;     // 精確搜尋走訪的節點數 (SAT 為衝突數)
+};
+
+CoverResult SolveCover(const CoverProblem& problem, const CoverOptions& opts);
+
+// 不配置記憶體的版本：暫存陣列都從 arena 切出 (呼叫結束後歸還)，結果寫進 out
+// out 重複使用時保留 cols 的容量，穩定狀態下不再向 heap 要記憶體
+void SolveCover(const CoverProblem& problem, const CoverOptions& opts, Arena& arena, CoverResult& out);
+
+#endif // COVER_H
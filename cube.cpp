@@ -0,0 +1,67 @@
+#include "cube.h"
+
+// --- 與 Implicant 互換 ---
+Cube CubeFromImplicant(const Implicant& imp, int numVars) {
+    Cube c = CUBE_UNIVERSE;
+    for (int v = 0; v < numVars; v++) {
+        int bit = numVars - 1 - v;
+        if ((imp.mask >> bit) & 1) continue;
+        c &= CubeLiteral(v, (imp.value >> bit) & 1);
+    }
+    return c;
+}
+
+Implicant CubeToImplicant(Cube c, int numVars) {
+    Implicant imp = { 0, 0 };
+    for (int v = 0; v < numVars; v++) {
+        int bit = numVars - 1 - v;
+        int field = CubeVarValue(c, v);
+        if (field == 3) imp.mask |= 1u << bit;
+        else if (field == 2) imp.value |= 1u << bit;
+    }
+    return imp;
+}
+
+// --- 字串 ---
+Cube ParseCube(const std::string& pattern) {
+    if (pattern.empty() || pattern.size() > (size_t)CUBE_MAX_VARS) return 0;
+    Cube c = CUBE_UNIVERSE;
+    for (size_t v = 0; v < pattern.size(); v++) {
+        uint64_t field;
+        if (pattern[v] == '0') field = 1;
+        else if (pattern[v] == '1') field = 2;
+        else if (pattern[v] == '-' || pattern[v] == '2') field = 3;
+        else return 0;
+        c = (c & ~CubeVarField((int)v)) | (field << (2 * v));
+    }
+    return c;
+}
+
+static char VarName(int v) { return v < 26 ? (char)('A' + v) : (char)('a' + v - 26); }
+
+std::string GetCubeTerm(Cube cube, int numVars, bool isPOS) {
+    if (numVars == 4 && !CubeIsEmpty(CubeNormalize(cube, 4))) return CubeTerm4(cube, isPOS);
+    if (CubeLiteralCount(CubeNormalize(cube, numVars)) == 0) return isPOS ? "0" : "1";
+    std::string term = isPOS ? "(" : "";
+    bool first = true;
+    for (int v = 0; v < numVars; v++) {
+        if (CubeIsFree(cube, v)) continue;
+        if (isPOS && !first) term += "+";
+        term += VarName(v);
+        bool positive = CubeVarValue(cube, v) == 2;
+        if (positive == isPOS) term += "'";
+        first = false;
+    }
+    if (isPOS) term += ")";
+    return term;
+}
+
+std::string GenerateCubeFormula(const CubeList& cubes, int numVars, bool isPOS) {
+    if (cubes.empty()) return isPOS ? "F = 1" : "F = 0";
+    std::string formula = "F = ";
+    for (size_t i = 0; i < cubes.size(); i++) {
+        formula += GetCubeTerm(cubes[i], numVars, isPOS);
+        if (i < cubes.size() - 1) formula += (isPOS ? "" : " + ");
+    }
+    return formula;
+}
@@ -0,0 +1,139 @@
+// 位置記號乘積項 (positional cube)：每個變數 2 個位元，一個 uint64_t 最多 32 個變數
+//   變數 i 佔 bit 2i..2i+1：01 = 0 (A')，10 = 1 (A)，11 = 不出現，00 = 空集合
+//   變數 0 為 A；未使用的變數欄位固定為 11，因此全 1 即為整個空間 (常數 1)
+// 交集、包含、距離、consensus、合併都是不含分支的整數位元運算
+#ifndef CUBE_H
+#define CUBE_H
+
+#include "bit_utils.h"
+#include "implicant_table.h"
+#include "qm.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef uint64_t Cube;
+typedef std::vector<Cube> CubeList;
+
+const int CUBE_MAX_VARS = 32;
+const Cube CUBE_UNIVERSE = ~0ull;
+const uint64_t CUBE_FIELD_LOW = 0x5555555555555555ull; // 每個欄位的低位元
+
+// --- 欄位 ---
+inline constexpr uint64_t CubeVarField(int v) { return 3ull << (2 * v); }
+
+// 每個為 00 (空) 的欄位在低位元標 1
+inline constexpr uint64_t CubeEmptyFields(Cube c) { return ~(c | (c >> 1)) & CUBE_FIELD_LOW; }
+inline constexpr bool CubeIsEmpty(Cube c) { return CubeEmptyFields(c) != 0; }
+
+// 出現在乘積項中的變數 (欄位不是 11)，以低位元表示
+inline constexpr uint64_t CubeSpecifiedFields(Cube c) { return ~(c & (c >> 1)) & CUBE_FIELD_LOW; }
+inline int CubeLiteralCount(Cube c) { return PopCount64(CubeSpecifiedFields(c)); }
+inline constexpr bool CubeIsFree(Cube c, int v) { return (c & CubeVarField(v)) == CubeVarField(v); }
+
+// 變數 v 的欄位值 (1 = 0，2 = 1，3 = 不出現)
+inline constexpr int CubeVarValue(Cube c, int v) { return (int)((c >> (2 * v)) & 3); }
+
+// 只有變數 v = val 的乘積項
+inline constexpr Cube CubeLiteral(int v, int val) { return ~CubeVarField(v) | ((val ? 2ull : 1ull) << (2 * v)); }
+
+// 未使用的變數欄位設為 11
+inline constexpr Cube CubeNormalize(Cube c, int numVars) {
+    return numVars < CUBE_MAX_VARS ? c | (~0ull << (2 * numVars)) : c;
+}
+
+// --- 集合運算 ---
+// 交集 (可能為空)
+inline constexpr Cube CubeIntersect(Cube a, Cube b) { return a & b; }
+inline constexpr bool CubesIntersect(Cube a, Cube b) { return CubeEmptyFields(a & b) == 0; }
+inline constexpr bool CubeContains(Cube outer, Cube inner) { return (outer & inner) == inner; }
+// 包含兩者的最小乘積項
+inline constexpr Cube CubeSupercube(Cube a, Cube b) { return a | b; }
+
+// 兩個乘積項衝突 (一邊 A、一邊 A') 的變數數
+inline int CubeDistance(Cube a, Cube b) { return PopCount64(CubeEmptyFields(a & b)); }
+
+// consensus：距離 0 時為交集，距離 1 時為交集並放寬衝突的變數，距離 >= 2 時為空 (回傳 0)
+inline constexpr Cube CubeConsensus(Cube a, Cube b) {
+    uint64_t conflict = CubeEmptyFields(a & b);
+    Cube c = (a & b) | conflict | (conflict << 1);
+    return c & (0 - (uint64_t)((conflict & (conflict - 1)) == 0));
+}
+
+// 只差一個變數且該變數互補 (A 與 A') 時合併成一個乘積項，否則回傳 0
+inline constexpr Cube CubeMerge(Cube a, Cube b) {
+    uint64_t diff = a ^ b;
+    uint64_t both = diff & (diff >> 1) & CUBE_FIELD_LOW;
+    bool single = both != 0 && (both & (both - 1)) == 0 && diff == both * 3;
+    return (a | b) & (0 - (uint64_t)single);
+}
+
+// 對 p 取 cofactor (呼叫端需先確認兩者相交)：p 指定的變數放寬
+inline constexpr Cube CubeCofactor(Cube c, Cube p) { return c | ~p; }
+
+// --- 與 Implicant (QM 格式，A 為最高位元) 互換 ---
+Cube CubeFromImplicant(const Implicant& imp, int numVars);
+Implicant CubeToImplicant(Cube c, int numVars);
+
+// --- 4 變數卡諾圖 ---
+// 低 8 位元 (A..D 四個欄位) 即決定 IMPLICANT_TABLE 中的框，文字也直接查表
+const int CUBE4_TERM_SIZE = 16; // "(A'+B'+C'+D')" 加結尾
+
+constexpr Cube CubeFromCareValue4(int care, int value) {
+    Cube c = CUBE_UNIVERSE;
+    for (int v = 0; v < 4; v++) {
+        int bit = 3 - v;
+        if ((care >> bit) & 1) c = (c & ~CubeVarField(v)) | ((((value >> bit) & 1) ? 2ull : 1ull) << (2 * v));
+    }
+    return c;
+}
+
+constexpr Cube CubeFromRect(int rect) {
+    return CubeFromCareValue4(IMPLICANT_TABLE.rects[rect].care, IMPLICANT_TABLE.rects[rect].value);
+}
+
+struct Cube4Table {
+    int8_t rect[256];                    // 沒有空欄位時為 IMPLICANT_TABLE 的索引，否則 -1
+    char term[2][256][CUBE4_TERM_SIZE];  // [isPOS][低 8 位元]
+
+    constexpr Cube4Table() : rect{}, term{} {
+        for (int i = 0; i < 256; i++) rect[i] = -1;
+        for (int r = 0; r < IMPLICANT_COUNT; r++) {
+            const int index = (int)(CubeFromRect(r) & 0xFF);
+            rect[index] = (int8_t)r;
+            for (int pos = 0; pos < 2; pos++) {
+                char* out = term[pos][index];
+                int n = 0;
+                if (IMPLICANT_TABLE.rects[r].care == 0) { out[n++] = pos ? '0' : '1'; continue; }
+                if (pos) out[n++] = '(';
+                bool first = true;
+                for (int v = 0; v < 4; v++) {
+                    int field = (index >> (2 * v)) & 3;
+                    if (field == 3) continue;
+                    if (pos && !first) out[n++] = '+';
+                    out[n++] = (char)('A' + v);
+                    // POS 取補數：值為 1 的變數寫成 A'
+                    if ((field == 2) == (pos != 0)) out[n++] = '\'';
+                    first = false;
+                }
+                if (pos) out[n++] = ')';
+            }
+        }
+    }
+};
+
+inline constexpr Cube4Table CUBE4_TABLE{};
+
+// 高位欄位不影響結果 (只看 A..D)
+inline int CubeToRect(Cube c) { return CUBE4_TABLE.rect[c & 0xFF]; }
+// 有空欄位時回傳空字串
+inline const char* CubeTerm4(Cube c, bool isPOS) { return CUBE4_TABLE.term[isPOS ? 1 : 0][c & 0xFF]; }
+
+// --- 字串 ---
+// 由 "01-1" 形式的字串建立乘積項 (第一個字元為變數 A)，格式錯誤時回傳 0
+Cube ParseCube(const std::string& pattern);
+std::string GetCubeTerm(Cube cube, int numVars, bool isPOS);
+std::string GenerateCubeFormula(const CubeList& cubes, int numVars, bool isPOS);
+
+#endif // CUBE_H
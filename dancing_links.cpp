@@ -0,0 +1,177 @@
+#include "dancing_links.h"
+#include "bit_utils.h"
+#include "bitset_kernels.h"
+#include <algorithm>
+
+CoverEnumerator::CoverEnumerator(const CoverProblem& p, const CoverOptions& opts, size_t limit) : limit(limit) {
+    // 最低成本：沿用精確覆蓋引擎 (化簡規則讓它比列舉快很多)
+    CoverOptions exact = opts;
+    exact.method = CoverMethod::Exact;
+    CoverResult best = SolveCover(p, exact);
+    target = best.cost;
+    optimal = best.optimal;
+    complete = best.complete;
+    if (!complete) { done = true; return; }
+
+    numItems = p.numRows;
+    int numNodes = numItems + 1;
+    for (int c = 0; c < p.numCols; c++) numNodes += BitsCount(p.Col(c), (size_t)p.rowWords);
+    left.resize(numItems + 1);
+    right.resize(numItems + 1);
+    up.resize(numNodes);
+    down.resize(numNodes);
+    top.assign(numNodes, 0);
+    len.assign(numItems + 1, 0);
+    optionOf.assign(numNodes, -1);
+    for (int i = 0; i <= numItems; i++) {
+        left[i] = i == 0 ? numItems : i - 1;
+        right[i] = i == numItems ? 0 : i + 1;
+        up[i] = down[i] = i;
+    }
+
+    optionStart.resize(p.numCols + 1);
+    optionCost.resize(p.numCols);
+    int n = numItems + 1;
+    for (int c = 0; c < p.numCols; c++) {
+        optionStart[c] = n;
+        optionCost[c] = p.Cost(c);
+        const uint64_t* col = p.Col(c);
+        for (int w = 0; w < p.rowWords; w++) {
+            for (uint64_t m = col[w]; m; m &= m - 1) {
+                int item = w * 64 + CountTrailingZeros64(m) + 1;
+                top[n] = item;
+                optionOf[n] = c;
+                up[n] = up[item];
+                down[n] = item;
+                down[up[item]] = n;
+                up[item] = n;
+                len[item]++;
+                n++;
+            }
+        }
+    }
+    optionStart[p.numCols] = n;
+    stamp.assign(p.numCols, 0);
+    isHidden.assign(numItems + 1, 0);
+}
+
+// 可用質項最少的待覆蓋列 (最容易失敗的先做)
+int CoverEnumerator::ChooseItem() const {
+    int best = right[0];
+    for (int i = right[best]; i != 0; i = right[i]) if (len[i] < len[best]) best = i;
+    return best;
+}
+
+// 彼此沒有共同可用質項的待覆蓋列，每一列至少要付出它最便宜的質項
+int CoverEnumerator::LowerBound() {
+    stampValue++;
+    int bound = 0;
+    for (int i = right[0]; i != 0; i = right[i]) {
+        bool shared = false;
+        int cheapest = 0;
+        for (int n = down[i]; n != i; n = down[n]) {
+            int o = optionOf[n];
+            if (stamp[o] == stampValue) { shared = true; break; }
+            if (cheapest == 0 || optionCost[o] < cheapest) cheapest = optionCost[o];
+        }
+        if (shared) continue;
+        bound += cheapest;
+        for (int n = down[i]; n != i; n = down[n]) stamp[optionOf[n]] = stampValue;
+    }
+    return bound;
+}
+
+// 選中 lv.node 的質項：它覆蓋的列移出待覆蓋串列
+void CoverEnumerator::Select(Level& lv) {
+    int o = optionOf[lv.node];
+    lv.hiddenMark = hidden.size();
+    for (int n = optionStart[o]; n < optionStart[o + 1]; n++) {
+        int i = top[n];
+        if (isHidden[i]) continue;
+        right[left[i]] = right[i];
+        left[right[i]] = left[i];
+        isHidden[i] = 1;
+        hidden.push_back(i);
+    }
+    cost += optionCost[o];
+}
+
+void CoverEnumerator::Unselect(Level& lv) {
+    while (hidden.size() > lv.hiddenMark) {
+        int i = hidden.back();
+        hidden.pop_back();
+        right[left[i]] = i;
+        left[right[i]] = i;
+        isHidden[i] = 0;
+    }
+    cost -= optionCost[optionOf[lv.node]];
+}
+
+// 質項從它所在的每一列的串列中拿掉 (節點本身的 up / down 保留，之後可以原樣接回)
+void CoverEnumerator::Exclude(int o) {
+    for (int n = optionStart[o]; n < optionStart[o + 1]; n++) {
+        up[down[n]] = up[n];
+        down[up[n]] = down[n];
+        len[top[n]]--;
+    }
+    excluded.push_back(o);
+}
+
+void CoverEnumerator::Restore(size_t mark) {
+    while (excluded.size() > mark) {
+        int o = excluded.back();
+        excluded.pop_back();
+        for (int n = optionStart[o + 1] - 1; n >= optionStart[o]; n--) {
+            up[down[n]] = n;
+            down[up[n]] = n;
+            len[top[n]]++;
+        }
+    }
+}
+
+// 從 lv.node 開始找下一個不超出成本的質項並選中；這一列試完時接回這一層排除的質項並回傳 false
+bool CoverEnumerator::Advance(Level& lv) {
+    while (lv.node != lv.item) {
+        int o = optionOf[lv.node];
+        if (cost + optionCost[o] <= target) { Select(lv); return true; }
+        Exclude(o);
+        lv.node = down[lv.node];
+    }
+    Restore(lv.excludedMark);
+    return false;
+}
+
+bool CoverEnumerator::Next(std::vector<int>& cols) {
+    if (done || (limit && produced >= limit)) return false;
+    // 上一次停在一組解上 (堆疊最上層的質項仍是選中狀態)，從回溯開始
+    bool descend = !started;
+    started = true;
+    while (true) {
+        if (descend) {
+            if (right[0] == 0) {
+                cols.clear();
+                for (const Level& lv : stack) cols.push_back(optionOf[lv.node]);
+                std::sort(cols.begin(), cols.end());
+                produced++;
+                return true;
+            }
+            int item = ChooseItem();
+            if (len[item] > 0 && cost + LowerBound() <= target) {
+                Level lv = { item, down[item], 0, excluded.size() };
+                stack.push_back(lv);
+                if (Advance(stack.back())) continue;
+                stack.pop_back();
+            }
+            descend = false;
+        }
+
+        // 回溯：換掉最上層選中的質項，之後的分支不再使用它
+        if (stack.empty()) { done = true; return false; }
+        Level& lv = stack.back();
+        Unselect(lv);
+        Exclude(optionOf[lv.node]);
+        lv.node = down[lv.node];
+        if (Advance(lv)) { descend = true; continue; }
+        stack.pop_back();
+    }
+}
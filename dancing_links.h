@@ -0,0 +1,68 @@
+// 列舉所有最低成本的覆蓋：質項表上的 Algorithm X (Dancing Links)
+// 質項覆蓋不是 exact cover (一格可以被多個質項覆蓋)：選中質項時只把它覆蓋的列移出待覆蓋串列，
+// 其他質項仍然可用；同一層試過的質項從各列的串列中拿掉，因此每一組覆蓋只會出現一次
+#ifndef DANCING_LINKS_H
+#define DANCING_LINKS_H
+
+#include "cover.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CoverEnumerator {
+public:
+    // 先以精確覆蓋求出最低成本 (opts 的預算同樣適用)，之後每次 Next 從上次停下的地方繼續搜尋
+    // limit = 0 表示不限數量
+    CoverEnumerator(const CoverProblem& problem, const CoverOptions& opts = CoverOptions(), size_t limit = 0);
+
+    // 下一組成本等於 MinCost() 的覆蓋 (質項索引由小到大)；沒有更多或達到上限時回傳 false
+    bool Next(std::vector<int>& cols);
+
+    int MinCost() const { return target; }
+    bool Optimal() const { return optimal; } // MinCost 已被證明為最低 (預算用完時只列舉與目前最佳解同成本的覆蓋)
+    bool Complete() const { return complete; } // 所有列都能被覆蓋
+    size_t Count() const { return produced; }
+
+private:
+    struct Level {
+        int item;          // 這一層要覆蓋的列
+        int node;          // 目前選中的質項在這一列的節點
+        size_t hiddenMark; // 選中前已移出的列數
+        size_t excludedMark; // 進入這一層時已排除的質項數
+    };
+
+    // 節點 0 為待覆蓋串列的表頭，1..numItems 為各列的表頭，之後是各質項的節點 (同一質項的節點連續)
+    int numItems = 0;
+    std::vector<int> left, right;    // 待覆蓋串列 (只用於表頭)
+    std::vector<int> up, down, top;  // 各列可用質項的串列
+    std::vector<int> len;            // 各列可用的質項數
+    std::vector<int> optionOf;       // 節點所屬的質項
+    std::vector<int> optionStart;    // 質項 o 的節點為 [optionStart[o], optionStart[o + 1])
+    std::vector<int> optionCost;
+
+    std::vector<Level> stack;
+    std::vector<uint8_t> isHidden;   // 列已被選中的質項覆蓋
+    std::vector<int> hidden;         // 依序移出的列
+    std::vector<int> excluded;       // 依序排除的質項
+    std::vector<int> stamp;          // 下界計算用的質項標記
+    int stampValue = 0;
+
+    int target = 0;
+    int cost = 0;
+    bool optimal = false;
+    bool complete = true;
+    bool started = false;
+    bool done = false;
+    size_t limit;
+    size_t produced = 0;
+
+    int ChooseItem() const;
+    int LowerBound();
+    void Select(Level& lv);
+    void Unselect(Level& lv);
+    void Exclude(int option);
+    void Restore(size_t mark);
+    bool Advance(Level& lv);
+};
+
+#endif // DANCING_LINKS_H
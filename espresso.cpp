@@ -0,0 +1,490 @@
+#include "espresso.h"
+#include "bit_utils.h"
+#include "truth_table.h"
+#include <algorithm>
+#include <cmath>
+
+// --- 乘積項列表運算 ---
+// 對乘積項 p 取 cofactor 並附加到 out：與 p 不相交的項捨去，其餘把 p 指定的變數放寬
+static void AppendCofactor(CubeList& out, const CubeList& cubes, uint64_t p) {
+    for (uint64_t c : cubes) if (CubesIntersect(c, p)) out.push_back(CubeCofactor(c, p));
+}
+
+static CubeList Cofactor(const CubeList& cubes, uint64_t p) {
+    CubeList out;
+    out.reserve(cubes.size());
+    AppendCofactor(out, cubes, p);
+    return out;
+}
+
+// 遞迴用的共用堆疊：每一層的列表是 stack[begin, size())，子層的 cofactor 附加在尾端
+// 每一層返回前把 stack 截回 begin，整個遞迴共用同一塊記憶體
+static void PushCofactor(CubeList& stack, size_t begin, size_t end, uint64_t p) {
+    for (size_t i = begin; i < end; i++) if (CubesIntersect(stack[i], p)) stack.push_back(CubeCofactor(stack[i], p));
+}
+
+// 最適合拿來展開的變數：優先同時以 A 與 A' 出現 (binate) 的變數，沒有則挑出現最多次的
+// 有 binate 變數時只需替它們計數
+static int SplitVar(const uint64_t* cubes, size_t count) {
+    uint64_t seenZero = 0, seenOne = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t spec = CubeSpecifiedFields(cubes[i]);
+        seenZero |= cubes[i] & spec;
+        seenOne |= (cubes[i] >> 1) & spec;
+    }
+    uint64_t candidates = (seenZero & seenOne) ? (seenZero & seenOne) : (seenZero | seenOne);
+    int zeros[CUBE_MAX_VARS] = {0}, ones[CUBE_MAX_VARS] = {0};
+    for (size_t i = 0; i < count; i++) {
+        uint64_t c = cubes[i];
+        for (uint64_t m = CubeSpecifiedFields(c) & candidates; m; m &= m - 1) {
+            int v = CountTrailingZeros64(m) / 2;
+            if ((c >> (2 * v)) & 1) zeros[v]++;
+            else ones[v]++;
+        }
+    }
+    int best = -1, bestBinate = -1, bestTotal = 0;
+    for (uint64_t m = candidates; m; m &= m - 1) {
+        int v = CountTrailingZeros64(m) / 2;
+        int binate = std::min(zeros[v], ones[v]);
+        if (binate > bestBinate || (binate == bestBinate && zeros[v] + ones[v] > bestTotal)) {
+            best = v; bestBinate = binate; bestTotal = zeros[v] + ones[v];
+        }
+    }
+    return best;
+}
+
+// 列表中出現的變數 (active，每個變數欄位的低位元) 不多時改用真值表，不再遞迴：
+// 第 j 個出現的變數在 j < 6 時對應 word 內的 TRUTH_VAR_MASKS[j]，其餘對應 word 編號的第 j - 6 位元
+// 不滿 6 個變數時一個 word 內是重複的副本，整個 word 都可以直接比較
+const int SMALL_TABLE_VARS = 14;
+const int SMALL_TABLE_WORDS = 1 << (SMALL_TABLE_VARS - 6);
+
+struct SmallTable {
+    uint64_t words[SMALL_TABLE_WORDS];
+    int numWords;
+    int vars[SMALL_TABLE_VARS];
+    int numVars;
+};
+
+// 列表中各項的聯集
+static void SmallCoverTable(const uint64_t* cubes, size_t count, uint64_t active, SmallTable& t) {
+    t.numVars = 0;
+    for (uint64_t m = active; m; m &= m - 1) t.vars[t.numVars++] = CountTrailingZeros64(m) / 2;
+    t.numWords = t.numVars > 6 ? 1 << (t.numVars - 6) : 1;
+    std::fill(t.words, t.words + t.numWords, 0);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t minterms = ~0ull;
+        int wordMask = 0, wordValue = 0;
+        for (int j = 0; j < t.numVars; j++) {
+            int value = CubeVarValue(cubes[i], t.vars[j]);
+            if (value == 3) continue;
+            if (j < 6) minterms &= value == 2 ? TRUTH_VAR_MASKS[j] : ~TRUTH_VAR_MASKS[j];
+            else {
+                wordMask |= 1 << (j - 6);
+                if (value == 2) wordValue |= 1 << (j - 6);
+            }
+        }
+        // 只走訪符合固定位元的 word (其餘位元的所有子集)
+        const int freeBits = (t.numWords - 1) & ~wordMask;
+        for (int sub = freeBits;; sub = (sub - 1) & freeBits) {
+            t.words[sub | wordValue] |= minterms;
+            if (!sub) break;
+        }
+    }
+}
+
+// stack[begin, size()) 是否為恆真 (tautology)；返回時 stack 截回 begin
+static bool Tautology(CubeList& stack, size_t begin) {
+    size_t end = stack.size();
+    uint64_t seenZero = 0, seenOne = 0;
+    double volume = 0.0;
+    for (size_t i = begin; i < end; i++) {
+        uint64_t c = stack[i];
+        if (c == CUBE_UNIVERSE) { stack.resize(begin); return true; }
+        uint64_t spec = CubeSpecifiedFields(c);
+        seenOne |= (c >> 1) & spec;
+        seenZero |= c & spec;
+        volume += std::ldexp(1.0, -PopCount64(spec));
+    }
+    // 所有項的 minterm 數加起來不到整個空間 (包含空列表)，不可能恆真
+    if (volume < 1.0) { stack.resize(begin); return false; }
+
+    if (PopCount64(seenZero | seenOne) <= SMALL_TABLE_VARS) {
+        SmallTable t;
+        SmallCoverTable(stack.data() + begin, end - begin, seenZero | seenOne, t);
+        stack.resize(begin);
+        for (int w = 0; w < t.numWords; w++) if (t.words[w] != ~0ull) return false;
+        return true;
+    }
+
+    // unate 縮減：只以單一極性出現的變數，含有它的項可以忽略 (原地移除)
+    uint64_t unate = seenZero ^ seenOne;
+    if (unate) {
+        size_t kept = begin;
+        for (size_t i = begin; i < end; i++) if ((CubeSpecifiedFields(stack[i]) & unate) == 0) stack[kept++] = stack[i];
+        stack.resize(kept);
+        return Tautology(stack, begin);
+    }
+    // 先展開項數較少的一半：不是恆真時通常較快找到缺口
+    int v = SplitVar(stack.data() + begin, end - begin);
+    size_t zeros = 0, ones = 0;
+    for (size_t i = begin; i < end; i++) {
+        int value = CubeVarValue(stack[i], v);
+        if (value == 1) zeros++;
+        else if (value == 2) ones++;
+    }
+    int first = zeros < ones ? 0 : 1;
+    PushCofactor(stack, begin, end, CubeLiteral(v, first));
+    bool taut = Tautology(stack, end);
+    if (taut) {
+        PushCofactor(stack, begin, end, CubeLiteral(v, !first));
+        taut = Tautology(stack, end);
+    }
+    stack.resize(begin);
+    return taut;
+}
+
+// c 是否被 cubes 完全覆蓋；stack 為呼叫端重複使用的暫存
+static bool CubeCovered(uint64_t c, const CubeList& cubes, CubeList& stack) {
+    stack.clear();
+    AppendCofactor(stack, cubes, c);
+    return Tautology(stack, 0);
+}
+
+static void RemoveContained(CubeList& cubes) {
+    std::sort(cubes.begin(), cubes.end(), [](uint64_t a, uint64_t b) {
+        int la = CubeLiteralCount(a), lb = CubeLiteralCount(b);
+        return la != lb ? la < lb : a < b;
+    });
+    CubeList kept;
+    for (uint64_t c : cubes) {
+        bool contained = false;
+        for (uint64_t k : kept) if (CubeContains(k, c)) { contained = true; break; }
+        if (!contained) kept.push_back(c);
+    }
+    cubes.swap(kept);
+}
+
+CubeList ComplementCubes(int numVars, const CubeList& cubes) {
+    if (cubes.empty()) return CubeList(1, CUBE_UNIVERSE);
+    for (uint64_t c : cubes) if (c == CUBE_UNIVERSE) return CubeList();
+
+    if (cubes.size() == 1) {
+        // De Morgan：每個文字取反各成一項
+        CubeList out;
+        uint64_t c = cubes[0];
+        for (int v = 0; v < numVars; v++) {
+            if (CubeIsFree(c, v)) continue;
+            out.push_back(~CubeVarField(v) | ((c ^ CubeVarField(v)) & CubeVarField(v)));
+        }
+        return out;
+    }
+
+    int v = SplitVar(cubes.data(), cubes.size());
+    CubeList c1 = ComplementCubes(numVars, Cofactor(cubes, CubeLiteral(v, 1)));
+    CubeList c0 = ComplementCubes(numVars, Cofactor(cubes, CubeLiteral(v, 0)));
+    std::sort(c1.begin(), c1.end());
+    std::sort(c0.begin(), c0.end());
+
+    // 兩邊都有的項不需要加上變數 v；各半邊本身已無包含關係，
+    // 只需檢查帶有 v 的項是否被共同項包含
+    CubeList common, out;
+    size_t i = 0, j = 0;
+    while (i < c1.size() && j < c0.size()) {
+        if (c1[i] < c0[j]) i++;
+        else if (c0[j] < c1[i]) j++;
+        else { common.push_back(c1[i]); i++; j++; }
+    }
+    auto addSide = [&](const CubeList& side, uint64_t literal) {
+        for (uint64_t c : side) {
+            bool contained = false;
+            for (uint64_t k : common) if (CubeContains(k, c)) { contained = true; break; }
+            if (!contained) out.push_back(c & literal);
+        }
+    };
+    addSide(c1, CubeLiteral(v, 1));
+    addSide(c0, CubeLiteral(v, 0));
+    out.insert(out.end(), common.begin(), common.end());
+    return out;
+}
+
+// acc 與 stack[begin, size()) 的補數在 path 範圍內部分的最小包覆乘積項 (smallest cube containing the complement)
+// 列表已對 path 取過 cofactor；acc = 0 表示目前為空，沒有補數時原樣回傳；返回時 stack 截回 begin
+// acc 已包含的範圍不再展開：只差一個變數時只需知道補數在該變數的那個值上是否為空
+static uint64_t ComplementSupercube(CubeList& stack, size_t begin, uint64_t path, uint64_t acc) {
+    size_t end = stack.size();
+    uint64_t missing = path & ~acc;
+    uint64_t common = CUBE_UNIVERSE, specified = CUBE_FIELD_LOW, seenZero = 0, seenOne = 0;
+    bool universe = false;
+    for (size_t i = begin; i < end; i++) {
+        uint64_t c = stack[i], spec = CubeSpecifiedFields(c);
+        universe |= c == CUBE_UNIVERSE;
+        common &= c;
+        specified &= spec;
+        seenZero |= c & spec;
+        seenOne |= (c >> 1) & spec;
+    }
+    if ((acc && !missing) || universe) { stack.resize(begin); return acc; }
+    if (begin == end) return acc | path;
+
+    uint64_t active = seenZero | seenOne;
+    if (PopCount64(active) <= SMALL_TABLE_VARS) {
+        SmallTable t;
+        SmallCoverTable(stack.data() + begin, end - begin, active, t);
+        stack.resize(begin);
+        // 補數 (沒被蓋住的 minterm) 在 word 內的位元與所在 word 編號各自的聯集 / 交集
+        uint64_t holes = 0;
+        int anyWord = 0, allWords = t.numWords - 1;
+        for (int w = 0; w < t.numWords; w++) {
+            if (t.words[w] == ~0ull) continue;
+            holes |= ~t.words[w];
+            anyWord |= w;
+            allWords &= w;
+        }
+        if (!holes) return acc;
+        for (int j = 0; j < t.numVars; j++) {
+            bool zero, one;
+            if (j < 6) {
+                zero = (holes & ~TRUTH_VAR_MASKS[j]) != 0;
+                one = (holes & TRUTH_VAR_MASKS[j]) != 0;
+            } else {
+                zero = !((allWords >> (j - 6)) & 1);
+                one = (anyWord >> (j - 6)) & 1;
+            }
+            if (!zero) path &= CubeLiteral(t.vars[j], 1);
+            else if (!one) path &= CubeLiteral(t.vars[j], 0);
+        }
+        return acc | path;
+    }
+    if (acc && (missing & ~CubeVarField(CountTrailingZeros64(missing) / 2)) == 0) {
+        int v = CountTrailingZeros64(missing) / 2;
+        for (int value = 0; value < 2; value++) {
+            if (!(missing & (1ull << (2 * v + value)))) continue;
+            PushCofactor(stack, begin, end, CubeLiteral(v, value));
+            if (!Tautology(stack, end)) acc |= path & CubeLiteral(v, value);
+        }
+        stack.resize(begin);
+        return acc;
+    }
+    // unate 列表 (沒有宇集項) 的補數在每個變數的反向值上都不為空；
+    // 順向值上只有某項恰為該單一文字時 (cofactor 後成為宇集) 才為空
+    if ((seenZero & seenOne) == 0) {
+        uint64_t sup = CUBE_UNIVERSE;
+        for (size_t i = begin; i < end; i++) {
+            uint64_t spec = CubeSpecifiedFields(stack[i]);
+            if ((spec & (spec - 1)) == 0) sup &= ~stack[i] | ~(spec * 3);
+        }
+        stack.resize(begin);
+        return acc | (path & sup);
+    }
+    // 所有項都含同一個文字時，補數包含另一半的整個範圍，另一半有補數時就是整個 path
+    if (uint64_t shared = specified & ~CubeEmptyFields(common)) {
+        int v = CountTrailingZeros64(shared) / 2;
+        int value = CubeVarValue(common, v) == 2 ? 1 : 0;
+        acc |= path & CubeLiteral(v, !value);
+        PushCofactor(stack, begin, end, CubeLiteral(v, value));
+        bool taut = Tautology(stack, end);
+        stack.resize(begin);
+        return taut ? acc : acc | path;
+    }
+    int v = SplitVar(stack.data() + begin, end - begin);
+    PushCofactor(stack, begin, end, CubeLiteral(v, 1));
+    acc = ComplementSupercube(stack, end, path & CubeLiteral(v, 1), acc);
+    PushCofactor(stack, begin, end, CubeLiteral(v, 0));
+    acc = ComplementSupercube(stack, end, path & CubeLiteral(v, 0), acc);
+    stack.resize(begin);
+    return acc;
+}
+
+static bool CostLess(const CubeList& a, const CubeList& b) {
+    if (a.size() != b.size()) return a.size() < b.size();
+    int la = 0, lb = 0;
+    for (uint64_t c : a) la += CubeLiteralCount(c);
+    for (uint64_t c : b) lb += CubeLiteralCount(c);
+    return la < lb;
+}
+
+// 尚未處理的項 (排在後面且未被覆蓋) 在每個位元上出現的次數
+// 放寬 c 的變數 v 時的分數 = 在 v 上有 c 沒有的值的項數 (放寬後更接近)，即 c 在 v 缺少的那個位元的次數
+struct BitCounts {
+    int count[64] = {0};
+    void Add(uint64_t c, int delta) {
+        for (uint64_t m = c; m; m &= m - 1) count[CountTrailingZeros64(m)] += delta;
+    }
+    int Score(uint64_t c, int v) const { return count[CountTrailingZeros64(~c & CubeVarField(v))]; }
+};
+
+// --- EXPAND：在不碰到 off-set 的前提下放寬每個項，並移除被吃掉的項 ---
+static CubeList Expand(CubeList cubes, const CubeList& offSet) {
+    std::stable_sort(cubes.begin(), cubes.end(), [](uint64_t a, uint64_t b) { return CubeLiteralCount(a) < CubeLiteralCount(b); });
+    std::vector<char> covered(cubes.size(), 0);
+    std::vector<uint64_t> conflict(offSet.size());
+    CubeList out;
+    BitCounts scores;
+    for (uint64_t c : cubes) scores.Add(c, 1);
+
+    for (size_t i = 0; i < cubes.size(); i++) {
+        if (covered[i]) continue;
+        uint64_t c = cubes[i];
+        scores.Add(c, -1);
+        // conflict[k]：c 與 off-set 第 k 項互斥的變數，只剩一個時該變數不能放寬
+        for (size_t k = 0; k < offSet.size(); k++) conflict[k] = CubeEmptyFields(c & offSet[k]);
+
+        while (true) {
+            uint64_t blocked = 0;
+            for (uint64_t f : conflict) if ((f & (f - 1)) == 0) blocked |= f;
+            uint64_t candidates = CubeSpecifiedFields(c) & ~blocked;
+            if (!candidates) break;
+
+            // 挑選能讓 c 最接近其他尚未覆蓋項的變數
+            int bestVar = -1, bestScore = -1;
+            for (uint64_t m = candidates; m; m &= m - 1) {
+                int v = CountTrailingZeros64(m) / 2;
+                int score = scores.Score(c, v);
+                if (score > bestScore) { bestScore = score; bestVar = v; }
+            }
+            c |= CubeVarField(bestVar);
+            for (uint64_t& f : conflict) f &= ~(1ull << (2 * bestVar));
+        }
+
+        for (size_t j = i + 1; j < cubes.size(); j++) {
+            if (!covered[j] && CubeContains(c, cubes[j])) { covered[j] = 1; scores.Add(cubes[j], -1); }
+        }
+        out.push_back(c);
+    }
+    RemoveContained(out);
+    return out;
+}
+
+// 沒有明確 off-set 時改用包含測試：放寬後的項必須仍落在 on-set ∪ dc-set 之內
+// 省去計算補數 (隨機性高的函數補數可能非常龐大)
+static CubeList ExpandWithinCare(CubeList cubes, const CubeList& care) {
+    std::stable_sort(cubes.begin(), cubes.end(), [](uint64_t a, uint64_t b) { return CubeLiteralCount(a) < CubeLiteralCount(b); });
+    std::vector<char> covered(cubes.size(), 0);
+    CubeList out, stack;
+    BitCounts scores;
+    for (uint64_t c : cubes) scores.Add(c, 1);
+
+    for (size_t i = 0; i < cubes.size(); i++) {
+        if (covered[i]) continue;
+        uint64_t c = cubes[i];
+        scores.Add(c, -1);
+        std::vector<std::pair<int, int>> order; // (-score, var)
+        for (uint64_t m = CubeSpecifiedFields(c); m; m &= m - 1) {
+            int v = CountTrailingZeros64(m) / 2;
+            order.push_back({-scores.Score(c, v), v});
+        }
+        std::sort(order.begin(), order.end());
+        // c 已在 care 之內，放寬變數 v 只需檢查對面那一半 (v 取反) 是否也在 care 之內
+        for (auto& item : order) {
+            if (CubeCovered(c ^ CubeVarField(item.second), care, stack)) c |= CubeVarField(item.second);
+        }
+
+        for (size_t j = i + 1; j < cubes.size(); j++) {
+            if (!covered[j] && CubeContains(c, cubes[j])) { covered[j] = 1; scores.Add(cubes[j], -1); }
+        }
+        out.push_back(c);
+    }
+    RemoveContained(out);
+    return out;
+}
+
+// --- IRREDUNDANT：移除可被其他項與 don't care 覆蓋的項 ---
+// 先分出相對必要的項 (其他項與 dc 蓋不住)；其餘被必要項與 dc 就蓋住的直接移除，
+// 剩下部分多餘的項由小項開始逐一檢查，必要項與 dc 的 cofactor 每項只算一次
+static CubeList Irredundant(const CubeList& cubes, const CubeList& dcSet) {
+    const size_t n = cubes.size();
+    CubeList cof;
+    std::vector<char> essential(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        AppendCofactor(cof, dcSet, cubes[i]);
+        for (size_t j = 0; j < n; j++) {
+            if (j != i && CubesIntersect(cubes[j], cubes[i])) cof.push_back(CubeCofactor(cubes[j], cubes[i]));
+        }
+        essential[i] = !Tautology(cof, 0);
+    }
+
+    CubeList base = dcSet; // 必要項 ∪ dc
+    for (size_t i = 0; i < n; i++) if (essential[i]) base.push_back(cubes[i]);
+    std::vector<size_t> partial;
+    std::vector<CubeList> baseCof(n);
+    for (size_t i = 0; i < n; i++) {
+        if (essential[i]) continue;
+        AppendCofactor(baseCof[i], base, cubes[i]);
+        cof = baseCof[i];
+        if (!Tautology(cof, 0)) partial.push_back(i);
+    }
+    std::stable_sort(partial.begin(), partial.end(), [&](size_t a, size_t b) { return CubeLiteralCount(cubes[a]) > CubeLiteralCount(cubes[b]); });
+
+    std::vector<char> kept(essential);
+    for (size_t i : partial) kept[i] = 1;
+    for (size_t i : partial) {
+        cof = baseCof[i];
+        for (size_t j : partial) {
+            if (j != i && kept[j] && CubesIntersect(cubes[j], cubes[i])) cof.push_back(CubeCofactor(cubes[j], cubes[i]));
+        }
+        if (Tautology(cof, 0)) kept[i] = 0;
+    }
+    CubeList out;
+    for (size_t i = 0; i < n; i++) if (kept[i]) out.push_back(cubes[i]);
+    return out;
+}
+
+// --- REDUCE：把每個項縮到仍必要的最小範圍，讓下一輪 EXPAND 能換方向 ---
+// 每個項對同一份列表 (略過自己與已移除的項) 與 dc 取 cofactor
+static CubeList Reduce(CubeList cubes, const CubeList& dcSet) {
+    std::stable_sort(cubes.begin(), cubes.end(), [](uint64_t a, uint64_t b) { return CubeLiteralCount(a) < CubeLiteralCount(b); });
+    std::vector<char> removed(cubes.size(), 0);
+    CubeList cof;
+    for (size_t i = 0; i < cubes.size(); i++) {
+        AppendCofactor(cof, dcSet, cubes[i]);
+        for (size_t j = 0; j < cubes.size(); j++) {
+            if (j != i && !removed[j] && CubesIntersect(cubes[j], cubes[i])) cof.push_back(CubeCofactor(cubes[j], cubes[i]));
+        }
+        uint64_t reduced = ComplementSupercube(cof, 0, cubes[i], 0);
+        if (CubeEmptyFields(reduced)) removed[i] = 1;
+        else cubes[i] = reduced;
+    }
+    CubeList out;
+    for (size_t i = 0; i < cubes.size(); i++) if (!removed[i]) out.push_back(cubes[i]);
+    return out;
+}
+
+EspressoResult Espresso(int numVars, const CubeList& onSet, const CubeList& dcSet, bool isPOS,
+                        const CubeList* offSet, const EspressoOptions& opts) {
+    EspressoResult result;
+    if (numVars < 1 || numVars > ESPRESSO_MAX_VARS) return result;
+
+    CubeList on, dc;
+    for (uint64_t c : onSet) { c = CubeNormalize(c, numVars); if (!CubeEmptyFields(c)) on.push_back(c); }
+    for (uint64_t c : dcSet) { c = CubeNormalize(c, numVars); if (!CubeEmptyFields(c)) dc.push_back(c); }
+
+    // 沒有 off-set 又是 SOP 時，不計算補數
+    CubeList care = on;
+    care.insert(care.end(), dc.begin(), dc.end());
+    CubeList off;
+    bool useOffSet = offSet != nullptr || isPOS;
+    if (offSet) {
+        for (uint64_t c : *offSet) { c = CubeNormalize(c, numVars); if (!CubeEmptyFields(c)) off.push_back(c); }
+    } else if (isPOS) {
+        off = ComplementCubes(numVars, care);
+    }
+    // 改為覆蓋 0：原本的 on-set 成為 EXPAND 時不可碰到的部分
+    if (isPOS) on.swap(off);
+    if (on.empty()) return result;
+
+    auto expand = [&](const CubeList& cubes) {
+        return useOffSet ? Expand(cubes, off) : ExpandWithinCare(cubes, care);
+    };
+
+    RemoveContained(on);
+    CubeList cover = Irredundant(expand(on), dc);
+    for (int it = 0; it < opts.maxIterations; it++) {
+        result.iterations++;
+        CubeList next = Irredundant(expand(Reduce(cover, dc)), dc);
+        if (!CostLess(next, cover)) break;
+        cover.swap(next);
+    }
+    result.cover = cover;
+    return result;
+}
@@ -0,0 +1,30 @@
+// Espresso 風格的啟發式兩階化簡 (EXPAND / IRREDUNDANT / REDUCE)，適用 16–32 個輸入
+#ifndef ESPRESSO_H
+#define ESPRESSO_H
+
+#include "cube.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 輸入與輸出皆為位置記號乘積項 (見 cube.h)
+const int ESPRESSO_MAX_VARS = CUBE_MAX_VARS;
+
+struct EspressoOptions {
+    int maxIterations = 20; // REDUCE / EXPAND / IRREDUNDANT 迴圈上限
+};
+
+struct EspressoResult {
+    CubeList cover;
+    int iterations = 0;
+};
+
+// onSet / dcSet 為輸入的乘積項列表；offSet 為 nullptr 時由 onSet ∪ dcSet 取補數求得
+// isPOS 與 isPOSMode 相同：改為覆蓋 0 的部分，輸出以 POS 形式解讀
+EspressoResult Espresso(int numVars, const CubeList& onSet, const CubeList& dcSet, bool isPOS,
+                        const CubeList* offSet = nullptr, const EspressoOptions& opts = EspressoOptions());
+
+// 乘積項的補數 (De Morgan / Shannon 展開)
+CubeList ComplementCubes(int numVars, const CubeList& cubes);
+
+#endif // ESPRESSO_H
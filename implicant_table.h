@@ -0,0 +1,118 @@
+// 4 變數卡諾圖的所有矩形質項候選 (含環繞)，於編譯期產生
+#ifndef IMPLICANT_TABLE_H
+#define IMPLICANT_TABLE_H
+
+#include <cstdint>
+
+// 格子位元遮罩：bit index = minterm 編號 (A 為最高位)，即 GRAY_CODES[r] * 4 + GRAY_CODES[c]
+typedef uint16_t CellMask;
+
+constexpr int GRAY_CODES[4] = { 0, 1, 3, 2 };
+
+constexpr int CellBit(int r, int c) { return GRAY_CODES[r] * 4 + GRAY_CODES[c]; }
+
+struct ImplicantRect {
+    uint8_t r, c, h, w;
+    CellMask mask;      // 覆蓋的格子
+    uint8_t care;       // 出現在乘積項中的變數 (bit3 = A ... bit0 = D)
+    uint8_t value;      // 各變數的值 (只有 care 位元有意義)
+    uint8_t segCount;   // 環繞拆開後的矩形數 (1, 2 或 4)
+    uint8_t seg[4][4];  // 每段為 {c, r, w, h}，單位為格
+};
+
+const int IMPLICANT_COUNT = 81; // 3^4
+
+struct ImplicantTable {
+    ImplicantRect rects[IMPLICANT_COUNT];
+
+    constexpr ImplicantTable() : rects{} {
+        // 由大到小排列，與原本 shapes[][2] 的搜尋順序一致
+        const int shapes[9][2] = { {4,4}, {2,4}, {4,2}, {1,4}, {4,1}, {2,2}, {1,2}, {2,1}, {1,1} };
+        int n = 0;
+        for (int s = 0; s < 9; s++) {
+            int h = shapes[s][0];
+            int w = shapes[s][1];
+            int maxR = (h == 4) ? 1 : 4;
+            int maxC = (w == 4) ? 1 : 4;
+            for (int r = 0; r < maxR; r++) {
+                for (int c = 0; c < maxC; c++) {
+                    ImplicantRect& t = rects[n++];
+                    t.r = (uint8_t)r; t.c = (uint8_t)c; t.h = (uint8_t)h; t.w = (uint8_t)w;
+
+                    CellMask mask = 0;
+                    for (int i = 0; i < h; i++) for (int j = 0; j < w; j++)
+                        mask = (CellMask)(mask | (1u << CellBit((r + i) % 4, (c + j) % 4)));
+                    t.mask = mask;
+
+                    // 列 (AB) 與行 (CD) 的 Gray code 中維持不變的位元即為乘積項的文字
+                    int rowAnd = 0b11, rowOr = 0b00, colAnd = 0b11, colOr = 0b00;
+                    for (int i = 0; i < h; i++) { rowAnd &= GRAY_CODES[(r + i) % 4]; rowOr |= GRAY_CODES[(r + i) % 4]; }
+                    for (int j = 0; j < w; j++) { colAnd &= GRAY_CODES[(c + j) % 4]; colOr |= GRAY_CODES[(c + j) % 4]; }
+                    int rowCare = ~(rowAnd ^ rowOr) & 0b11;
+                    int colCare = ~(colAnd ^ colOr) & 0b11;
+                    t.care = (uint8_t)((rowCare << 2) | colCare);
+                    t.value = (uint8_t)(((rowAnd << 2) | colAnd) & t.care);
+
+                    int hs[2][2] = {}, vs[2][2] = {};
+                    int hCount = 0, vCount = 0;
+                    if (c + w <= 4) { hs[hCount][0] = c; hs[hCount++][1] = w; }
+                    else { hs[hCount][0] = c; hs[hCount++][1] = 4 - c; hs[hCount][0] = 0; hs[hCount++][1] = w - (4 - c); }
+                    if (r + h <= 4) { vs[vCount][0] = r; vs[vCount++][1] = h; }
+                    else { vs[vCount][0] = r; vs[vCount++][1] = 4 - r; vs[vCount][0] = 0; vs[vCount++][1] = h - (4 - r); }
+                    int k = 0;
+                    for (int a = 0; a < hCount; a++) for (int b = 0; b < vCount; b++) {
+                        t.seg[k][0] = (uint8_t)hs[a][0]; t.seg[k][1] = (uint8_t)vs[b][0];
+                        t.seg[k][2] = (uint8_t)hs[a][1]; t.seg[k][3] = (uint8_t)vs[b][1];
+                        k++;
+                    }
+                    t.segCount = (uint8_t)k;
+                }
+            }
+        }
+    }
+};
+
+inline constexpr ImplicantTable IMPLICANT_TABLE{};
+
+// 由文字樣式 (care / value，bit3 = A) 找回表中的索引，找不到回傳 -1
+constexpr int FindImplicantRect(int care, int value) {
+    for (int i = 0; i < IMPLICANT_COUNT; i++) {
+        const ImplicantRect& t = IMPLICANT_TABLE.rects[i];
+        if (t.care == (care & 0xF) && t.value == (value & care & 0xF)) return i;
+    }
+    return -1;
+}
+
+// --- 編譯期檢查 ---
+constexpr int CountTableEntries() {
+    int n = 0;
+    for (const auto& t : IMPLICANT_TABLE.rects) if (t.h != 0) n++;
+    return n;
+}
+
+constexpr bool TableMasksConsistent() {
+    for (int i = 0; i < IMPLICANT_COUNT; i++) {
+        const ImplicantRect& t = IMPLICANT_TABLE.rects[i];
+        int cells = 0;
+        for (int b = 0; b < 16; b++) if ((t.mask >> b) & 1) cells++;
+        if (cells != t.h * t.w) return false;
+        // 乘積項的文字數必須與框大小對應：每少一個文字，格子數加倍
+        int literals = 0;
+        for (int b = 0; b < 4; b++) if ((t.care >> b) & 1) literals++;
+        if (cells != (1 << (4 - literals))) return false;
+        for (int j = 0; j < i; j++) if (IMPLICANT_TABLE.rects[j].mask == t.mask) return false;
+    }
+    return true;
+}
+
+constexpr bool TableCoversEveryCell() {
+    CellMask unit = 0;
+    for (const auto& t : IMPLICANT_TABLE.rects) if (t.h == 1 && t.w == 1) unit = (CellMask)(unit | t.mask);
+    return unit == 0xFFFF && IMPLICANT_TABLE.rects[0].mask == 0xFFFF;
+}
+
+static_assert(CountTableEntries() == IMPLICANT_COUNT, "implicant table must hold every 4-variable cube");
+static_assert(TableMasksConsistent(), "implicant masks must be distinct and match their literal count");
+static_assert(TableCoversEveryCell(), "implicant table must cover every cell");
+
+#endif // IMPLICANT_TABLE_H
@@ -0,0 +1,283 @@
+#include "incremental_solver.h"
+#include "bit_utils.h"
+#include <algorithm>
+
+// 依序走訪乘積項內的每一格
+template <typename F>
+static void ForEachCell(const Implicant& cube, F f) {
+    uint32_t sub = 0;
+    do {
+        f(cube.value | sub);
+        sub = (sub - cube.mask) & cube.mask;
+    } while (sub != 0);
+}
+
+static bool KeyLess(const Implicant& a, const Implicant& b) { return a.Key() < b.Key(); }
+
+// --- 完整重解 ---
+void IncrementalSolver::Solve(int vars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet,
+                              const CoverOptions& options) {
+    opts = options;
+    if (vars < QM_MIN_VARS || vars > QM_MAX_VARS) { numVars = 0; primes.clear(); cover.clear(); return; }
+    numVars = vars;
+    varMask = (uint32_t)((1ull << vars) - 1);
+    roles.assign((size_t)1 << vars, (uint8_t)CellRole::Off);
+    for (uint32_t m : dcSet) if ((m & ~varMask) == 0) roles[m] = (uint8_t)CellRole::DontCare;
+    for (uint32_t m : onSet) if ((m & ~varMask) == 0) roles[m] = (uint8_t)CellRole::On;
+    SolveFromRoles();
+}
+
+void IncrementalSolver::SolveFromRoles() {
+    std::vector<uint32_t> onSet, dcSet;
+    for (uint32_t m = 0; m < (uint32_t)roles.size(); m++) {
+        if (roles[m] == (uint8_t)CellRole::On) onSet.push_back(m);
+        else if (roles[m] == (uint8_t)CellRole::DontCare) dcSet.push_back(m);
+    }
+    onCount = (int)onSet.size();
+    primes = GeneratePrimes(numVars, onSet, dcSet, opts.parallel);
+    cover.clear();
+    coverValid = false;
+    coverDirty = true;
+    dirtyCells.clear();
+    stats.fullSolves++;
+}
+
+bool IncrementalSolver::Update(const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet) {
+    if (!Ready()) return false;
+    std::vector<uint8_t> next(roles.size(), (uint8_t)CellRole::Off);
+    for (uint32_t m : dcSet) if ((m & ~varMask) == 0) next[m] = (uint8_t)CellRole::DontCare;
+    for (uint32_t m : onSet) if ((m & ~varMask) == 0) next[m] = (uint8_t)CellRole::On;
+
+    std::vector<uint32_t> changed;
+    for (uint32_t m = 0; m < (uint32_t)next.size(); m++) {
+        if (next[m] == roles[m]) continue;
+        changed.push_back(m);
+        if ((int)changed.size() > INCREMENTAL_MAX_CHANGES) break;
+    }
+    if ((int)changed.size() > INCREMENTAL_MAX_CHANGES) {
+        roles.swap(next);
+        SolveFromRoles();
+        return false;
+    }
+    for (uint32_t m : changed) {
+        if (!ApplyCell(m, (CellRole)next[m])) {
+            // 超出預算：補上其餘的格子後只完整重解一次
+            roles.swap(next);
+            SolveFromRoles();
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- 單格變更 ---
+bool IncrementalSolver::SetCell(uint32_t cell, CellRole role) {
+    if (!Ready() || (cell & ~varMask) != 0) return false;
+    if (ApplyCell(cell, role)) return true;
+    SolveFromRoles();
+    return false;
+}
+
+// 超出預算時回傳 false，質項表停在一半，由呼叫端完整重解
+bool IncrementalSolver::ApplyCell(uint32_t cell, CellRole role) {
+    CellRole old = (CellRole)roles[cell];
+    if (old == role) return true;
+
+    if (old == CellRole::On) onCount--;
+    if (role == CellRole::On) onCount++;
+    roles[cell] = (uint8_t)role;
+    dirtyCells.push_back(cell);
+    coverDirty = true;
+
+    // On <-> DontCare 不影響質項，只影響覆蓋
+    bool wasAllowed = old != CellRole::Off;
+    bool nowAllowed = role != CellRole::Off;
+    if (wasAllowed && !nowAllowed) {
+        RemoveCellFromAllowed(cell);
+    } else if (!wasAllowed && nowAllowed && !AddCellToAllowed(cell)) {
+        return false;
+    }
+    stats.incrementalUpdates++;
+    return true;
+}
+
+bool IncrementalSolver::AllAllowed(const Implicant& cube) {
+    budget += (uint64_t)1 << PopCount32(cube.mask);
+    bool all = true;
+    uint32_t sub = 0;
+    do {
+        if (!Allowed(cube.value | sub)) { all = false; break; }
+        sub = (sub - cube.mask) & cube.mask;
+    } while (sub != 0);
+    return all;
+}
+
+// cube 已在可覆蓋範圍內：任何一個文字拿掉後都會碰到不可覆蓋的格子時即為質項
+bool IncrementalSolver::IsPrime(const Implicant& cube) {
+    for (uint32_t fixed = varMask & ~cube.mask; fixed; fixed &= fixed - 1) {
+        uint32_t bit = fixed & (0u - fixed);
+        if (AllAllowed({cube.value ^ bit, cube.mask})) return false;
+    }
+    return true;
+}
+
+// 格子變成不可覆蓋：含有它的質項消失，它們避開該格的最大子乘積項是新質項的唯一候選
+// (新質項在原本的函數中必被某個舊質項包含，而沒有碰到該格的舊質項仍然是質項)
+void IncrementalSolver::RemoveCellFromAllowed(uint32_t cell) {
+    std::vector<Implicant> removed;
+    for (size_t i = 0; i < primes.size();) {
+        if (primes[i].Covers(cell)) {
+            removed.push_back(primes[i]);
+            primes[i] = primes.back();
+            primes.pop_back();
+        } else {
+            i++;
+        }
+    }
+
+    std::vector<Implicant> candidates;
+    for (const Implicant& p : removed) {
+        for (uint32_t freeBits = p.mask; freeBits; freeBits &= freeBits - 1) {
+            uint32_t bit = freeBits & (0u - freeBits);
+            candidates.push_back({p.value | (~cell & bit), p.mask & ~bit});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), KeyLess);
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    for (const Implicant& c : candidates) if (IsPrime(c)) primes.push_back(c);
+}
+
+// 格子變成可覆蓋：與它相距一個文字的舊質項可能可以擴大 (不再是質項)，
+// 新質項必定含有該格，從該格出發列舉
+bool IncrementalSolver::AddCellToAllowed(uint32_t cell) {
+    budget = 0;
+    for (size_t i = 0; i < primes.size();) {
+        const Implicant& p = primes[i];
+        uint32_t diff = (cell & ~p.mask) ^ p.value;
+        if (PopCount32(diff) == 1 && AllAllowed({p.value ^ diff, p.mask})) {
+            primes[i] = primes.back();
+            primes.pop_back();
+        } else {
+            i++;
+        }
+    }
+    CollectPrimesThrough({cell, 0}, 0);
+    return budget <= INCREMENTAL_SEARCH_BUDGET;
+}
+
+// 依變數編號遞增加入自由變數，每個含起點格的合法乘積項只會走訪一次
+void IncrementalSolver::CollectPrimesThrough(Implicant cube, int nextVar) {
+    if (budget > INCREMENTAL_SEARCH_BUDGET) return;
+    uint32_t expandable = 0;
+    for (uint32_t fixed = varMask & ~cube.mask; fixed; fixed &= fixed - 1) {
+        uint32_t bit = fixed & (0u - fixed);
+        if (AllAllowed({cube.value ^ bit, cube.mask})) expandable |= bit;
+    }
+    if (expandable == 0) { primes.push_back(cube); return; }
+    for (uint32_t next = expandable & ~((1u << nextVar) - 1); next; next &= next - 1) {
+        int v = CountTrailingZeros64(next);
+        uint32_t bit = 1u << v;
+        CollectPrimesThrough({cube.value & ~bit, cube.mask | bit}, v + 1);
+    }
+}
+
+// --- 覆蓋 ---
+const std::vector<Implicant>& IncrementalSolver::Cover() {
+    if (!coverDirty || !Ready()) return cover;
+    if (!coverValid || onCount < INCREMENTAL_LOCAL_COVER_ROWS || (int)dirtyCells.size() > INCREMENTAL_MAX_CHANGES) {
+        FullCover();
+    } else {
+        RepairCover();
+    }
+    dirtyCells.clear();
+    coverDirty = false;
+    return cover;
+}
+
+// 與 SolveQM 相同的質項表，質項依 Key 排序讓結果與質項的更新順序無關
+void IncrementalSolver::FullCover() {
+    std::vector<int> rowOf(roles.size(), -1);
+    int numRows = 0;
+    for (uint32_t m = 0; m < (uint32_t)roles.size(); m++) if (roles[m] == (uint8_t)CellRole::On) rowOf[m] = numRows++;
+
+    std::vector<Implicant> columns;
+    for (const Implicant& p : primes) {
+        bool touchesOn = false;
+        ForEachCell(p, [&](uint32_t m) { if (rowOf[m] >= 0) touchesOn = true; });
+        if (touchesOn) columns.push_back(p);
+    }
+    std::sort(columns.begin(), columns.end(), KeyLess);
+
+    CoverProblem chart;
+    chart.Init(numRows, (int)columns.size());
+    for (size_t c = 0; c < columns.size(); c++) {
+        ForEachCell(columns[c], [&](uint32_t m) { if (rowOf[m] >= 0) chart.Set((int)c, rowOf[m]); });
+    }
+    coverStats = SolveCover(chart, opts);
+
+    cover.clear();
+    coverCount.assign(roles.size(), 0);
+    for (int c : coverStats.cols) AddToCover(columns[c]);
+    coverValid = true;
+}
+
+void IncrementalSolver::AddToCover(const Implicant& imp) {
+    cover.push_back(imp);
+    ForEachCell(imp, [&](uint32_t m) { coverCount[m]++; });
+}
+
+void IncrementalSolver::RemoveFromCover(size_t index) {
+    ForEachCell(cover[index], [&](uint32_t m) { coverCount[m]--; });
+    cover.erase(cover.begin() + index);
+}
+
+bool IncrementalSolver::Redundant(const Implicant& imp) const {
+    bool redundant = true;
+    ForEachCell(imp, [&](uint32_t m) {
+        if (roles[m] == (uint8_t)CellRole::On && coverCount[m] < 2) redundant = false;
+    });
+    return redundant;
+}
+
+// 沿用上一次的覆蓋：移除不再是質項的項，改變過的格子若沒被覆蓋就補上最划算的質項，再刪掉多餘的項
+void IncrementalSolver::RepairCover() {
+    std::vector<uint32_t> touched = dirtyCells;
+    for (size_t i = cover.size(); i-- > 0;) {
+        const Implicant t = cover[i];
+        if (AllAllowed(t) && IsPrime(t)) continue;
+        ForEachCell(t, [&](uint32_t m) { touched.push_back(m); });
+        RemoveFromCover(i);
+    }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+    bool complete = true;
+    for (uint32_t u : touched) {
+        if (roles[u] != (uint8_t)CellRole::On || coverCount[u] != 0) continue;
+        int best = -1, bestGain = 0;
+        for (size_t i = 0; i < primes.size(); i++) {
+            if (!primes[i].Covers(u)) continue;
+            int gain = 0;
+            ForEachCell(primes[i], [&](uint32_t m) {
+                if (roles[m] == (uint8_t)CellRole::On && coverCount[m] == 0) gain++;
+            });
+            if (best < 0 || gain > bestGain || (gain == bestGain && KeyLess(primes[i], primes[best]))) {
+                best = (int)i;
+                bestGain = gain;
+            }
+        }
+        if (best < 0) { complete = false; continue; }
+        AddToCover(primes[best]);
+    }
+
+    // 只檢查碰到改變區域的項，由後往前 (新加入的項先被考慮)
+    for (size_t i = cover.size(); i-- > 0;) {
+        bool near = false;
+        for (uint32_t m : touched) if (cover[i].Covers(m)) { near = true; break; }
+        if (near && Redundant(cover[i])) RemoveFromCover(i);
+    }
+
+    coverStats = CoverResult();
+    coverStats.complete = complete;
+    stats.localCoverRepairs++;
+}
@@ -0,0 +1,85 @@
+// 增量化簡：格子逐一改變時只更新碰到該格的質項與覆蓋 (拖曳塗色用)
+#ifndef INCREMENTAL_SOLVER_H
+#define INCREMENTAL_SOLVER_H
+
+#include "qm.h"
+#include <cstdint>
+#include <vector>
+
+enum class CellRole : uint8_t {
+    Off,      // 不可覆蓋
+    On,       // 必須覆蓋
+    DontCare  // 可選擇性覆蓋
+};
+
+const int INCREMENTAL_MAX_CHANGES = 16;        // 一次改變超過此格數時改為完整重解
+const int INCREMENTAL_LOCAL_COVER_ROWS = 256;  // 目標格少於此數時覆蓋直接重解 (質項表很小)
+const uint64_t INCREMENTAL_SEARCH_BUDGET = 1ull << 20; // 新增格子時列舉新質項的檢查格數上限
+
+struct IncrementalStats {
+    uint64_t incrementalUpdates = 0;
+    uint64_t fullSolves = 0;
+    uint64_t localCoverRepairs = 0;
+};
+
+class IncrementalSolver {
+public:
+    // 完整重解 (設定變數數與覆蓋選項)
+    void Solve(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet,
+               const CoverOptions& opts = CoverOptions());
+
+    // 與目前的格子比較：改變的格子不多時逐格局部更新，否則完整重解
+    // 回傳 true 表示走增量路徑
+    bool Update(const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet);
+
+    // 單格變更；列舉新質項超出預算時改為完整重解並回傳 false
+    bool SetCell(uint32_t cell, CellRole role);
+
+    bool Ready() const { return numVars > 0; }
+    int NumVars() const { return numVars; }
+    CellRole Role(uint32_t cell) const { return (CellRole)roles[cell]; }
+
+    // 所有質項 (含只覆蓋 Don't Care 的)，順序不固定
+    const std::vector<Implicant>& Primes() const { return primes; }
+
+    // 覆蓋在需要時才計算：目標格少時以 opts 完整求解，否則沿用上一次的覆蓋並局部修補
+    const std::vector<Implicant>& Cover();
+    const CoverResult& CoverStats() { Cover(); return coverStats; }
+
+    const IncrementalStats& Stats() const { return stats; }
+
+private:
+    int numVars = 0;
+    uint32_t varMask = 0;
+    CoverOptions opts;
+    std::vector<uint8_t> roles;       // 每格的 CellRole
+    std::vector<Implicant> primes;
+    int onCount = 0;
+
+    std::vector<Implicant> cover;
+    std::vector<uint16_t> coverCount; // 每格被幾個覆蓋項覆蓋
+    std::vector<uint32_t> dirtyCells; // 上次計算覆蓋後改變過的格子
+    CoverResult coverStats;
+    bool coverValid = false;          // cover / coverCount 對應某一次的狀態 (可局部修補)
+    bool coverDirty = true;
+
+    IncrementalStats stats;
+    uint64_t budget = 0;
+
+    void SolveFromRoles();
+    bool ApplyCell(uint32_t cell, CellRole role);
+    bool Allowed(uint32_t cell) const { return roles[cell] != (uint8_t)CellRole::Off; }
+    bool AllAllowed(const Implicant& cube);
+    bool IsPrime(const Implicant& cube);
+    void RemoveCellFromAllowed(uint32_t cell);
+    bool AddCellToAllowed(uint32_t cell);
+    void CollectPrimesThrough(Implicant cube, int nextVar);
+
+    void FullCover();
+    void RepairCover();
+    void AddToCover(const Implicant& imp);
+    void RemoveFromCover(size_t index);
+    bool Redundant(const Implicant& imp) const;
+};
+
+#endif // INCREMENTAL_SOLVER_H
@@ -0,0 +1,119 @@
+#include "isop.h"
+#include "arena.h"
+#include <cstring>
+
+// --- 單一 word (6 變數以內) ---
+// 不足 6 變數的函數先複製填滿 64 位元，常數 1 的判斷即為 ~0
+static bool Depends(uint64_t w, int var) { return (((w >> (1 << var)) ^ w) & ~TRUTH_VAR_MASKS[var]) != 0; }
+static uint64_t Cofactor0(uint64_t w, int var) { uint64_t x = w & ~TRUTH_VAR_MASKS[var]; return x | (x << (1 << var)); }
+static uint64_t Cofactor1(uint64_t w, int var) { uint64_t x = w & TRUTH_VAR_MASKS[var]; return x | (x >> (1 << var)); }
+
+static Implicant WithLiteral(Implicant cube, int var, bool positive) {
+    cube.mask &= ~(1u << var);
+    if (positive) cube.value |= 1u << var;
+    return cube;
+}
+
+// on <= 回傳值 <= onDc，產生的乘積項加上 cube 已有的字母後放進 cubes
+static uint64_t Isop6(uint64_t on, uint64_t onDc, int numVars, Implicant cube, std::vector<Implicant>& cubes) {
+    if (on == 0) return 0;
+    if (onDc == ~0ull) { cubes.push_back(cube); return ~0ull; }
+    // on 不是常數 0、onDc 不是常數 1，因此至少與一個變數有關
+    int var = numVars - 1;
+    while (!Depends(on, var) && !Depends(onDc, var)) var--;
+
+    uint64_t on0 = Cofactor0(on, var), on1 = Cofactor1(on, var);
+    uint64_t dc0 = Cofactor0(onDc, var), dc1 = Cofactor1(onDc, var);
+    // 只能由 x' 項 / x 項覆蓋的部分，剩下的由不含 x 的項覆蓋
+    uint64_t r0 = Isop6(on0 & ~dc1, dc0, var, WithLiteral(cube, var, false), cubes);
+    uint64_t r1 = Isop6(on1 & ~dc0, dc1, var, WithLiteral(cube, var, true), cubes);
+    uint64_t r2 = Isop6((on0 & ~r0) | (on1 & ~r1), dc0 & dc1, var, cube, cubes);
+    return (r0 & ~TRUTH_VAR_MASKS[var]) | (r1 & TRUTH_VAR_MASKS[var]) | r2;
+}
+
+// --- word 陣列 (超過 6 變數) ---
+// 最高的變數決定前後半段，餘因子就是兩個半段，不需要搬移位元；暫存空間從 arena 切出
+static void IsopWords(const uint64_t* on, const uint64_t* onDc, int numVars, Implicant cube,
+                      std::vector<Implicant>& cubes, Arena& arena, uint64_t* result) {
+    if (numVars <= 6) {
+        result[0] = Isop6(on[0], onDc[0], 6, cube, cubes);
+        return;
+    }
+    const size_t words = (size_t)1 << (numVars - 6), half = words / 2;
+    bool zero = true, one = true;
+    for (size_t k = 0; k < words; k++) {
+        if (on[k]) zero = false;
+        if (onDc[k] != ~0ull) one = false;
+    }
+    if (zero) { memset(result, 0, words * sizeof(uint64_t)); return; }
+    if (one) {
+        cubes.push_back(cube);
+        memset(result, 0xFF, words * sizeof(uint64_t));
+        return;
+    }
+
+    const int var = numVars - 1;
+    const uint64_t *on0 = on, *on1 = on + half, *dc0 = onDc, *dc1 = onDc + half;
+    if (memcmp(on0, on1, half * sizeof(uint64_t)) == 0 && memcmp(dc0, dc1, half * sizeof(uint64_t)) == 0) {
+        // 與最高的變數無關
+        IsopWords(on0, dc0, numVars - 1, cube, cubes, arena, result);
+        memcpy(result + half, result, half * sizeof(uint64_t));
+        return;
+    }
+
+    ArenaScope scope(arena);
+    uint64_t* part = arena.Alloc<uint64_t>(half);
+    uint64_t* both = arena.Alloc<uint64_t>(half);
+    uint64_t* r0 = arena.Alloc<uint64_t>(half);
+    uint64_t* r1 = arena.Alloc<uint64_t>(half);
+    uint64_t* r2 = arena.Alloc<uint64_t>(half);
+    for (size_t k = 0; k < half; k++) part[k] = on0[k] & ~dc1[k];
+    IsopWords(part, dc0, numVars - 1, WithLiteral(cube, var, false), cubes, arena, r0);
+    for (size_t k = 0; k < half; k++) part[k] = on1[k] & ~dc0[k];
+    IsopWords(part, dc1, numVars - 1, WithLiteral(cube, var, true), cubes, arena, r1);
+    for (size_t k = 0; k < half; k++) {
+        part[k] = (on0[k] & ~r0[k]) | (on1[k] & ~r1[k]);
+        both[k] = dc0[k] & dc1[k];
+    }
+    IsopWords(part, both, numVars - 1, cube, cubes, arena, r2);
+    for (size_t k = 0; k < half; k++) {
+        result[k] = r0[k] | r2[k];
+        result[half + k] = r1[k] | r2[k];
+    }
+}
+
+std::vector<Implicant> Isop(const TruthTable& onSet, const TruthTable& dcSet, TruthTable* cover) {
+    std::vector<Implicant> cubes;
+    const int numVars = onSet.NumVars();
+    const Implicant all = { 0, numVars >= 32 ? ~0u : (1u << numVars) - 1 };
+    TruthTable upper = onSet | dcSet;
+
+    if (numVars <= 6) {
+        uint64_t on = onSet.Words()[0], onDc = upper.Words()[0];
+        for (int width = 1 << numVars; width < 64; width *= 2) {
+            on |= on << width;
+            onDc |= onDc << width;
+        }
+        uint64_t f = Isop6(on, onDc, numVars, all, cubes);
+        if (cover) {
+            *cover = TruthTable(numVars);
+            cover->Words()[0] = numVars == 6 ? f : f & ((1ull << (1 << numVars)) - 1);
+        }
+        return cubes;
+    }
+
+    Arena arena;
+    TruthTable f(numVars);
+    IsopWords(onSet.Words(), upper.Words(), numVars, all, cubes, arena, f.Words());
+    if (cover) *cover = f;
+    return cubes;
+}
+
+std::vector<Implicant> SolveIsop(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet) {
+    if (numVars < 0 || numVars > TRUTH_TABLE_MAX_VARS) return {};
+    const uint32_t limit = 1u << numVars;
+    TruthTable on(numVars), dc(numVars);
+    for (uint32_t m : onSet) if (m < limit) on.Set(m);
+    for (uint32_t m : dcSet) if (m < limit) dc.Set(m);
+    return Isop(on, dc);
+}
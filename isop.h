@@ -0,0 +1,19 @@
+// Minato–Morreale ISOP：由真值表遞迴取餘因子，直接得到不可省略 (irredundant) 的乘積項列表
+// 不需要列舉所有質項，速度遠快於 QM / 精確覆蓋，但不保證最少項數 (互動時的快速解答)
+#ifndef ISOP_H
+#define ISOP_H
+
+#include "qm.h"
+#include "truth_table.h"
+#include <cstdint>
+#include <vector>
+
+// 回傳的乘積項聯集 f 滿足 onSet <= f <= onSet | dcSet，且拿掉任何一項或任何一個字母都不再成立
+// 乘積項格式與 QM 相同 (可交給 GenerateQMFormula，4 變數時可交給 GroupsFromImplicants)
+// cover 不為 nullptr 時寫入 f 的真值表
+std::vector<Implicant> Isop(const TruthTable& onSet, const TruthTable& dcSet, TruthTable* cover = nullptr);
+
+// 與 SolveQM 相同的輸入 (0–TRUTH_TABLE_MAX_VARS 變數，超出範圍時回傳空列表；超出 numVars 範圍的 minterm 會被忽略)
+std::vector<Implicant> SolveIsop(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet);
+
+#endif // ISOP_H
@@ -0,0 +1,353 @@
+#include "kmap_solver.h"
+#include "bit_utils.h"
+#include "isop.h"
+#include "kmap_template.h"
+#include <algorithm>
+#include <cstdio>
+
+const Color GROUP_COLORS[6] = {
+    { 255, 0, 127, 255 }, { 0, 255, 255, 255 },
+    { 255, 255, 0, 255 }, { 155, 89, 182, 255 },
+    { 255, 128, 0, 255 }, { 0, 255, 128, 255 }
+};
+
+// --- 輔助函數 ---
+bool IsCovered(const KMapGroup& g, int r, int c) {
+    return KMap<4>::IsCovered(g.mask, r, c);
+}
+
+bool IsSubset(const KMapGroup& sub, const KMapGroup& super) {
+    return KMap<4>::IsSubset(sub.mask, super.mask);
+}
+
+void GridToMasks(int data[4][4], int targetVal, CellMask& onMask, CellMask& dcMask) {
+    KMap<4>::GridToMasks(&data[0][0], targetVal, onMask, dcMask);
+}
+
+// 格子掃描順序 (row-major)，維持與原本逐格掃描相同的結果順序
+static const int CELL_ORDER[16] = {
+    0, 1, 3, 2, 4, 5, 7, 6, 12, 13, 15, 14, 8, 9, 11, 10
+};
+
+// --- 框框核心演算法 ---
+// 質項表：列依格子掃描順序排列，貪婪法的結果與逐格掃描相同
+// PIs 必須依 IMPLICANT_TABLE 的順序排列
+static void BuildChart(SolverContext& ctx, CellMask onMask, const KMapGroup* PIs, size_t count, const CoverOptions& opts) {
+    int rowOf[16];
+    int numRows = 0;
+    for (int bit : CELL_ORDER) if ((onMask >> bit) & 1) rowOf[bit] = numRows++;
+    ctx.chart.Init(numRows, (int)count);
+    for (size_t i = 0; i < count; i++) {
+        for (int bit = 0; bit < 16; bit++) if (((PIs[i].mask & onMask) >> bit) & 1) ctx.chart.Set((int)i, rowOf[bit]);
+        if (opts.costModel != CostModel::Terms) ctx.chart.SetCost((int)i, GroupCostUnder(PIs[i], opts.costModel));
+    }
+}
+
+// 結果寫進 ctx.groups / ctx.cover
+static void CoverKMapPrimes(SolverContext& ctx, CellMask onMask, const KMapGroup* PIs, size_t count,
+                            const CoverOptions& opts) {
+    BuildChart(ctx, onMask, PIs, count, opts);
+    SolveCover(ctx.chart, opts, ctx.arena, ctx.cover);
+    ctx.groups.clear();
+    for (int col : ctx.cover.cols) {
+        ctx.groups.push_back(PIs[col]);
+        ctx.groups.back().color = GROUP_COLORS[(ctx.groups.size() - 1) % 6];
+    }
+}
+
+// 質項：ctx.candidates 中沒有被其他候選框真包含的框 (不同框的格子集合必不相同)
+static void KeepPrimes(SolverContext& ctx) {
+    ctx.primes.clear();
+    for (const KMapGroup& gi : ctx.candidates) {
+        bool shouldRemove = false;
+        for (const KMapGroup& gj : ctx.candidates) {
+            if (gi.mask != gj.mask && (gi.mask & gj.mask) == gi.mask) { shouldRemove = true; break; }
+        }
+        if (!shouldRemove) ctx.primes.push_back(gi);
+    }
+}
+
+// 沒有目標格時的結果：空的覆蓋，已是最佳
+static void ClearSolution(SolverContext& ctx) {
+    ctx.groups.clear();
+    ctx.cover.cols.clear();
+    ctx.cover.optimal = true;
+    ctx.cover.complete = true;
+    ctx.cover.nodes = 0;
+}
+
+// 合法的框：不碰到非目標格，且至少含一個目標格
+static void CollectPrimes(SolverContext& ctx, CellMask onMask, CellMask dcMask) {
+    const CellMask allowed = onMask | dcMask;
+    ctx.candidates.clear();
+    for (int i = 0; i < IMPLICANT_COUNT; i++) {
+        CellMask m = IMPLICANT_TABLE.rects[i].mask;
+        if ((m & ~allowed) == 0 && (m & onMask) != 0) ctx.candidates.push_back(MakeGroup(i));
+    }
+    KeepPrimes(ctx);
+}
+
+const GroupList& SolveKMapMask(SolverContext& ctx, CellMask onMask, CellMask dcMask, const CoverOptions& opts) {
+    ClearSolution(ctx);
+    if (onMask == 0) return ctx.groups;
+
+    CollectPrimes(ctx, onMask, dcMask);
+    CoverKMapPrimes(ctx, onMask, ctx.primes.data(), ctx.primes.size(), opts);
+    return ctx.groups;
+}
+
+const GroupList& SolveKMap(SolverContext& ctx, int data[4][4], int targetVal, const CoverOptions& opts) {
+    CellMask onMask, dcMask;
+    GridToMasks(data, targetVal, onMask, dcMask);
+    return SolveKMapMask(ctx, onMask, dcMask, opts);
+}
+
+// 回傳 std::vector 的版本共用每個執行緒一份的 context
+static SolverContext& ThreadContext() {
+    static thread_local SolverContext ctx;
+    return ctx;
+}
+
+std::vector<KMapGroup> SolveKMapMask(CellMask onMask, CellMask dcMask, const CoverOptions& opts, CoverResult* stats) {
+    SolverContext& ctx = ThreadContext();
+    const GroupList& groups = SolveKMapMask(ctx, onMask, dcMask, opts);
+    if (stats) *stats = ctx.cover;
+    return std::vector<KMapGroup>(groups.begin(), groups.end());
+}
+
+std::vector<KMapGroup> SolveKMap(int data[4][4], int targetVal, const CoverOptions& opts, CoverResult* stats) {
+    CellMask onMask, dcMask;
+    GridToMasks(data, targetVal, onMask, dcMask);
+    return SolveKMapMask(onMask, dcMask, opts, stats);
+}
+
+// --- 列舉所有最低成本解 ---
+KMapSolutionEnumerator::KMapSolutionEnumerator(CellMask onMask, CellMask dcMask, const CoverOptions& opts, size_t limit) {
+    SolverContext& ctx = ThreadContext();
+    ctx.primes.clear();
+    if (onMask != 0) CollectPrimes(ctx, onMask, dcMask);
+    BuildChart(ctx, onMask, ctx.primes.data(), ctx.primes.size(), opts);
+    primes.assign(ctx.primes.begin(), ctx.primes.end());
+    enumerator.reset(new CoverEnumerator(ctx.chart, opts, limit));
+}
+
+bool KMapSolutionEnumerator::Next(std::vector<KMapGroup>& groups) {
+    if (!enumerator->Next(cols)) return false;
+    groups.clear();
+    for (int col : cols) {
+        groups.push_back(primes[col]);
+        groups.back().color = GROUP_COLORS[(groups.size() - 1) % 6];
+    }
+    return true;
+}
+
+// --- 成本 ---
+static int GateInputs(int literals) { return (literals >= 2 ? literals : 0) + 1; }
+
+int GroupCostUnder(const KMapGroup& g, CostModel model) {
+    return TermCostUnder(PopCount32(IMPLICANT_TABLE.rects[g.rect].care), model);
+}
+
+int TermCostUnder(int literals, CostModel model) {
+    switch (model) {
+    case CostModel::Literals: return literals > 0 ? literals : 1;
+    case CostModel::GateInputs: return GateInputs(literals);
+    default: return 1;
+    }
+}
+
+int FormCost::Total(CostModel model) const {
+    switch (model) {
+    case CostModel::Literals: return literals;
+    case CostModel::GateInputs: return gateInputs;
+    default: return terms;
+    }
+}
+
+bool FormCost::Cheaper(const FormCost& other, CostModel model) const {
+    if (Total(model) != other.Total(model)) return Total(model) < other.Total(model);
+    if (literals != other.literals) return literals < other.literals;
+    return terms < other.terms;
+}
+
+FormCost GroupCost(const KMapGroup* groups, size_t count) {
+    FormCost cost;
+    cost.terms = (int)count;
+    for (size_t i = 0; i < count; i++) {
+        int literals = PopCount32(IMPLICANT_TABLE.rects[groups[i].rect].care);
+        cost.literals += literals;
+        cost.gateInputs += GateInputs(literals);
+    }
+    return cost;
+}
+
+const char* CostModelName(CostModel model) {
+    switch (model) {
+    case CostModel::Literals: return "Literals";
+    case CostModel::GateInputs: return "Gate Inputs";
+    default: return "Terms";
+    }
+}
+
+// --- SOP / POS 同時化簡 ---
+
+// sides[i] 的 side 位元表示第 i 個框可用於這一邊，結果寫進 groups / stats
+static void SolveSide(SolverContext& ctx, const uint8_t* sides, uint8_t side, CellMask target,
+                      const CoverOptions& opts, GroupList& groups, CoverResult& stats) {
+    ClearSolution(ctx);
+    if (target != 0) {
+        ctx.candidates.clear();
+        for (int i = 0; i < IMPLICANT_COUNT; i++) if (sides[i] & side) ctx.candidates.push_back(MakeGroup(i));
+        KeepPrimes(ctx);
+        CoverKMapPrimes(ctx, target, ctx.primes.data(), ctx.primes.size(), opts);
+    }
+    groups = ctx.groups;
+    stats = ctx.cover;
+}
+
+void SolveKMapDual(SolverContext& ctx, CellMask onMask, CellMask dcMask, const CoverOptions& opts, DualSolution& out) {
+    const uint8_t SIDE_SOP = 1, SIDE_POS = 2;
+    dcMask = (CellMask)(dcMask & ~onMask);
+    const CellMask offMask = (CellMask)~(onMask | dcMask);
+
+    // 不碰到 0 且含有 1 的框可用於 SOP，不碰到 1 且含有 0 的框可用於 POS
+    uint8_t sides[IMPLICANT_COUNT];
+    for (int i = 0; i < IMPLICANT_COUNT; i++) {
+        CellMask m = IMPLICANT_TABLE.rects[i].mask;
+        sides[i] = 0;
+        if ((m & offMask) == 0 && (m & onMask) != 0) sides[i] |= SIDE_SOP;
+        if ((m & onMask) == 0 && (m & offMask) != 0) sides[i] |= SIDE_POS;
+    }
+
+    SolveSide(ctx, sides, SIDE_SOP, onMask, opts, out.sop, out.sopStats);
+    SolveSide(ctx, sides, SIDE_POS, offMask, opts, out.pos, out.posStats);
+    out.sopCost = GroupCost(out.sop.data(), out.sop.size());
+    out.posCost = GroupCost(out.pos.data(), out.pos.size());
+    out.posCheaper = out.posCost.Cheaper(out.sopCost, opts.costModel);
+}
+
+DualSolution SolveKMapDual(int data[4][4], const CoverOptions& opts) {
+    CellMask onMask, dcMask;
+    GridToMasks(data, VAL_1, onMask, dcMask);
+    DualSolution out;
+    SolveKMapDual(ThreadContext(), onMask, dcMask, opts, out);
+    return out;
+}
+
+// --- 增量化簡 ---
+std::vector<KMapGroup> KMapIncrementalSolver::Solve(int data[4][4], int targetVal, const CoverOptions& opts,
+                                                    CoverResult* stats) {
+    CellMask onMask, dcMask;
+    GridToMasks(data, targetVal, onMask, dcMask);
+    std::vector<uint32_t> onSet, dcSet;
+    for (int bit = 0; bit < 16; bit++) {
+        if ((onMask >> bit) & 1) onSet.push_back((uint32_t)bit);
+        else if ((dcMask >> bit) & 1) dcSet.push_back((uint32_t)bit);
+    }
+    if (solver.Ready()) solver.Update(onSet, dcSet);
+    else solver.Solve(4, onSet, dcSet, opts);
+
+    if (stats) { *stats = CoverResult(); stats->optimal = true; }
+    if (onMask == 0) return std::vector<KMapGroup>();
+
+    // 質項換回表中的框，依表的順序排列後用與 SolveKMapMask 相同的質項表求覆蓋
+    std::vector<int> rects;
+    for (const Implicant& p : solver.Primes()) {
+        int rect = FindImplicantRect(~p.mask & 0xF, p.value);
+        if (rect >= 0 && (IMPLICANT_TABLE.rects[rect].mask & onMask) != 0) rects.push_back(rect);
+    }
+    std::sort(rects.begin(), rects.end());
+    SolverContext& ctx = ThreadContext();
+    ctx.primes.clear();
+    for (int rect : rects) ctx.primes.push_back(MakeGroup(rect));
+    CoverKMapPrimes(ctx, onMask, ctx.primes.data(), ctx.primes.size(), opts);
+    if (stats) *stats = ctx.cover;
+    return std::vector<KMapGroup>(ctx.groups.begin(), ctx.groups.end());
+}
+
+TruthTable GroupsToTruthTable(const KMapGroup* groups, size_t count) {
+    CellMask covered = 0;
+    for (size_t i = 0; i < count; i++) covered = (CellMask)(covered | groups[i].mask);
+    return TruthTable::FromCellMask(covered);
+}
+
+std::vector<KMapGroup> GroupsFromImplicants(const std::vector<Implicant>& terms) {
+    std::vector<KMapGroup> groups;
+    for (const Implicant& imp : terms) {
+        int rect = FindImplicantRect(~imp.mask & 0xF, imp.value);
+        if (rect < 0) continue;
+        groups.push_back(MakeGroup(rect));
+        groups.back().color = GROUP_COLORS[(groups.size() - 1) % 6];
+    }
+    return groups;
+}
+
+std::vector<KMapGroup> SolveKMapIsop(CellMask onMask, CellMask dcMask) {
+    return GroupsFromImplicants(Isop(TruthTable::FromCellMask(onMask), TruthTable::FromCellMask(dcMask)));
+}
+
+// --- 字串生成 ---
+// 寫進固定大小的緩衝區：放不下的部分截斷，但長度照算
+struct TextWriter {
+    char* buf;
+    size_t size;
+    size_t length;
+
+    void Put(char c) {
+        if (length + 1 < size) buf[length] = c;
+        length++;
+    }
+    void Put(const char* s) { while (*s) Put(*s++); }
+    int Finish() {
+        if (size) buf[length < size ? length : size - 1] = '\0';
+        return (int)length;
+    }
+};
+
+// 文字由 CUBE4_TABLE 查表
+static void WriteTerm(TextWriter& out, const KMapGroup& g, bool isPOS) {
+    out.Put(CubeTerm4(GroupToCube(g), isPOS));
+}
+
+int FormatTerm(const KMapGroup& g, bool isPOS, char* buf, size_t size) {
+    TextWriter out = { buf, size, 0 };
+    WriteTerm(out, g, isPOS);
+    return out.Finish();
+}
+
+int FormatFormula(const KMapGroup* groups, size_t count, bool isPOS, char* buf, size_t size) {
+    TextWriter out = { buf, size, 0 };
+    if (count == 0) {
+        out.Put(isPOS ? "F = 1" : "F = 0");
+        return out.Finish();
+    }
+    out.Put("F = ");
+    for (size_t i = 0; i < count; i++) {
+        WriteTerm(out, groups[i], isPOS);
+        if (i < count - 1 && !isPOS) out.Put(" + ");
+    }
+    return out.Finish();
+}
+
+int FormatCost(const FormCost& cost, char* buf, size_t size) {
+    return snprintf(buf, size, "%d terms, %d literals, %d gate inputs", cost.terms, cost.literals, cost.gateInputs);
+}
+
+std::string DescribeCost(const FormCost& cost) {
+    char buf[96];
+    FormatCost(cost, buf, sizeof(buf));
+    return buf;
+}
+
+std::string GetTerm(const KMapGroup& g, bool isPOS) {
+    char buf[TERM_BUFFER_SIZE];
+    FormatTerm(g, isPOS, buf, sizeof(buf));
+    return buf;
+}
+
+std::string GenerateFormula(const std::vector<KMapGroup>& groups, bool isPOS) {
+    int length = FormatFormula(groups.data(), groups.size(), isPOS, nullptr, 0);
+    std::string formula((size_t)length, '\0');
+    FormatFormula(groups.data(), groups.size(), isPOS, &formula[0], (size_t)length + 1);
+    return formula;
+}
@@ -0,0 +1,174 @@
+// 卡諾圖化簡核心 (4 變數)
+#ifndef KMAP_SOLVER_H
+#define KMAP_SOLVER_H
+
+#include "raylib.h"
+#include "implicant_table.h"
+#include "cover.h"
+#include "qm.h"
+#include "cube.h"
+#include "incremental_solver.h"
+#include "dancing_links.h"
+#include "truth_table.h"
+#include "arena.h"
+#include "small_vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+
+// --- 定義常數 ---
+const int VAL_0 = 0;
+const int VAL_1 = 1;
+const int VAL_X = 2; // Don't Care
+
+// --- 資料結構 ---
+struct KMapGroup {
+    int r, c, h, w;
+    Color color;
+    CellMask mask; // 此框覆蓋的格子
+    int rect;      // IMPLICANT_TABLE 中的索引
+    bool operator==(const KMapGroup& other) const {
+        return rect == other.rect;
+    }
+};
+
+extern const Color GROUP_COLORS[6];
+
+inline KMapGroup MakeGroup(int rect) {
+    const ImplicantRect& t = IMPLICANT_TABLE.rects[rect];
+    return { t.r, t.c, t.h, t.w, WHITE, t.mask, rect };
+}
+
+// 框與位置記號乘積項互換 (A..D 為變數 0..3，查表完成)
+inline Cube GroupToCube(const KMapGroup& g) { return CubeFromRect(g.rect); }
+// 乘積項有空欄位時回傳 false
+inline bool CubeToGroup(Cube c, KMapGroup& g) {
+    int rect = CubeToRect(c);
+    if (rect < 0) return false;
+    g = MakeGroup(rect);
+    return true;
+}
+
+// --- 輔助函數 ---
+bool IsCovered(const KMapGroup& g, int r, int c);
+bool IsSubset(const KMapGroup& sub, const KMapGroup& super);
+
+// 將 data[4][4] 轉成目標格 / Don't Care 遮罩
+void GridToMasks(int data[4][4], int targetVal, CellMask& onMask, CellMask& dcMask);
+
+// --- 化簡 ---
+// onMask: 需要被覆蓋的格子，dcMask: 可選擇性覆蓋的格子
+// opts 選擇覆蓋方法 (貪婪 / 精確)、搜尋預算與成本模型，stats 可取得覆蓋引擎的結果資訊
+std::vector<KMapGroup> SolveKMapMask(CellMask onMask, CellMask dcMask,
+                                     const CoverOptions& opts = CoverOptions(), CoverResult* stats = nullptr);
+std::vector<KMapGroup> SolveKMap(int data[4][4], int targetVal,
+                                 const CoverOptions& opts = CoverOptions(), CoverResult* stats = nullptr);
+
+// 一次化簡的結果框數不超過格子數 (每個框至少覆蓋一個新的目標格)
+typedef SmallVec<KMapGroup, 16> GroupList;
+
+// 可重複使用的化簡環境：候選框、質項、質項表與覆蓋引擎的暫存空間都屬於這個物件
+// 同一個 context 反覆化簡時不再向 heap 要記憶體 (每畫面或批次呼叫用)，不可跨執行緒共用
+struct SolverContext {
+    Arena arena;
+    SmallVec<KMapGroup, IMPLICANT_COUNT> candidates;
+    SmallVec<KMapGroup, IMPLICANT_COUNT> primes;
+    CoverProblem chart;
+    CoverResult cover; // 最近一次化簡的覆蓋引擎結果
+    GroupList groups;
+};
+
+// 結果與 SolveKMapMask / SolveKMap 相同，回傳的參考在下一次使用 ctx 之前有效
+const GroupList& SolveKMapMask(SolverContext& ctx, CellMask onMask, CellMask dcMask,
+                               const CoverOptions& opts = CoverOptions());
+const GroupList& SolveKMap(SolverContext& ctx, int data[4][4], int targetVal,
+                           const CoverOptions& opts = CoverOptions());
+
+// 依序取得同一個格子所有最低成本的框組合 (opts 的成本模型與預算)，每次 Next 才繼續搜尋
+// 框依 IMPLICANT_TABLE 的順序排列；limit = 0 表示不限
+class KMapSolutionEnumerator {
+public:
+    KMapSolutionEnumerator(CellMask onMask, CellMask dcMask, const CoverOptions& opts = CoverOptions(), size_t limit = 0);
+    bool Next(std::vector<KMapGroup>& groups);
+    int MinCost() const { return enumerator->MinCost(); }
+
+private:
+    std::vector<KMapGroup> primes;
+    std::unique_ptr<CoverEnumerator> enumerator;
+    std::vector<int> cols;
+};
+
+// --- 成本 ---
+// 一個框在成本模型下的成本 (>= 1)，覆蓋引擎以此為質項的權重
+int GroupCostUnder(const KMapGroup& g, CostModel model);
+// 任意變數數的乘積項：只與字母數有關
+int TermCostUnder(int literals, CostModel model);
+
+// 實現成本 (常數項 1 / 0 算一項、零個字母)
+struct FormCost {
+    int terms = 0;
+    int literals = 0;
+    int gateInputs = 0;
+
+    int Total(CostModel model) const;
+    // 先比 model 下的成本，再比字母數、項數
+    bool Cheaper(const FormCost& other, CostModel model) const;
+};
+FormCost GroupCost(const KMapGroup* groups, size_t count);
+
+const char* CostModelName(CostModel model);
+// 例如 "3 terms, 7 literals, 10 gate inputs"
+std::string DescribeCost(const FormCost& cost);
+int FormatCost(const FormCost& cost, char* buf, size_t size);
+
+// --- SOP / POS 同時化簡 ---
+
+// sop 覆蓋 1 的格子、pos 覆蓋 0 的格子 (與 POS 模式 targetVal = VAL_0 的結果相同)
+struct DualSolution {
+    GroupList sop, pos;
+    CoverResult sopStats, posStats;
+    FormCost sopCost, posCost;
+    bool posCheaper = false; // 依 opts.costModel 比較，完全相同時選 SOP
+
+    const GroupList& Cheapest() const { return posCheaper ? pos : sop; }
+};
+
+// 一次走訪候選框同時分類兩邊 (Don't Care 兩邊共用)，兩個覆蓋共用 ctx 的暫存空間
+// onMask 為值為 1 的格子，其餘非 Don't Care 的格子為 0
+void SolveKMapDual(SolverContext& ctx, CellMask onMask, CellMask dcMask, const CoverOptions& opts, DualSolution& out);
+DualSolution SolveKMapDual(int data[4][4], const CoverOptions& opts = CoverOptions());
+
+// 拖曳塗色用：保留上一次的質項，與上一次的格子相比只改變少數格時局部更新
+// 覆蓋的建法與 SolveKMap 相同，因此結果一致
+class KMapIncrementalSolver {
+public:
+    std::vector<KMapGroup> Solve(int data[4][4], int targetVal,
+                                 const CoverOptions& opts = CoverOptions(), CoverResult* stats = nullptr);
+    const IncrementalStats& Stats() const { return solver.Stats(); }
+
+private:
+    IncrementalSolver solver;
+};
+
+// 框的聯集 (4 變數真值表)：SOP 時即為公式的函數，POS 時為公式等於 0 的格子
+TruthTable GroupsToTruthTable(const KMapGroup* groups, size_t count);
+
+// 4 變數的 Quine-McCluskey 結果轉成可繪製的框
+std::vector<KMapGroup> GroupsFromImplicants(const std::vector<Implicant>& terms);
+
+// 以 ISOP (真值表遞迴餘因子) 直接求不可省略的覆蓋：不列舉候選框，不保證框數最少
+std::vector<KMapGroup> SolveKMapIsop(CellMask onMask, CellMask dcMask);
+
+// --- 字串生成 ---
+std::string GetTerm(const KMapGroup& g, bool isPOS);
+std::string GenerateFormula(const std::vector<KMapGroup>& groups, bool isPOS);
+
+// 寫進呼叫端的緩衝區 (不配置記憶體)，超出 size 時截斷；回傳完整長度 (同 snprintf)
+// 乘積項最長為 "(A'+B'+C'+D')"，TERM_BUFFER_SIZE 必定放得下
+const int TERM_BUFFER_SIZE = 16;
+int FormatTerm(const KMapGroup& g, bool isPOS, char* buf, size_t size);
+int FormatFormula(const KMapGroup* groups, size_t count, bool isPOS, char* buf, size_t size);
+
+#endif // KMAP_SOLVER_H
@@ -0,0 +1,203 @@
+#include "kmap_template.h"
+#include "bit_utils.h"
+#include <algorithm>
+
+// --- 格子與質項 ---
+template <int N>
+void KMap<N>::GridToMasks(const int* data, int targetVal, Mask& onMask, Mask& dcMask) {
+    onMask = 0; dcMask = 0;
+    for (int r = 0; r < ROWS; r++) for (int c = 0; c < COLS; c++) {
+        int v = data[r * COLS + c];
+        if (v == targetVal) onMask = (Mask)(onMask | ((Mask)1 << CellBit(r, c)));
+        else if (v == VAL_X) dcMask = (Mask)(dcMask | ((Mask)1 << CellBit(r, c)));
+    }
+}
+
+template <int N>
+void KMap<N>::Primes(Mask onMask, Mask dcMask, std::vector<KMapTerm>& primes) {
+    const KMapCubeTable<N>& cubes = KMAP_CUBES<N>;
+    const Mask allowed = (Mask)(onMask | dcMask);
+    primes.clear();
+    for (int i = 0; i < KMapCubeTable<N>::COUNT; i++) {
+        const Mask cells = cubes.cells[i];
+        if (!IsSubset(cells, allowed) || (cells & onMask) == 0) continue;
+        // 拿掉一個字母 = 框沿該變數鏡射後合併
+        bool prime = true;
+        for (uint32_t rest = cubes.care[i]; rest && prime; rest &= rest - 1) {
+            if (IsSubset(FlipCells(cells, CountTrailingZeros64(rest)), allowed)) prime = false;
+        }
+        if (prime) primes.push_back({ cubes.care[i], cubes.value[i], (uint64_t)cells });
+    }
+}
+
+// 質項表的列依畫面上逐列掃描的順序排列 (N = 4 時與 SolveKMap 相同)
+template <int N>
+void KMap<N>::Solve(Mask onMask, Mask dcMask, const CoverOptions& opts, std::vector<KMapTerm>& terms, CoverResult* stats) {
+    onMask = (Mask)(onMask & FULL);
+    dcMask = (Mask)(dcMask & FULL & ~onMask);
+    terms.clear();
+    // 質項與質項表的暫存空間每個執行緒共用一份，穩定狀態下不再向 heap 要記憶體
+    static thread_local std::vector<KMapTerm> primes;
+    static thread_local CoverProblem chart;
+    static thread_local CoverResult result;
+    static thread_local Arena arena;
+    result.cols.clear();
+    result.cost = 0;
+    result.optimal = true;
+    result.complete = true;
+    result.nodes = 0;
+    if (onMask != 0) {
+        Primes(onMask, dcMask, primes);
+        int rowOf[CELLS];
+        int numRows = 0;
+        for (int r = 0; r < ROWS; r++) for (int c = 0; c < COLS; c++) {
+            int bit = CellBit(r, c);
+            if ((onMask >> bit) & 1) rowOf[bit] = numRows++;
+        }
+        chart.Init(numRows, (int)primes.size());
+        for (size_t i = 0; i < primes.size(); i++) {
+            for (uint64_t m = primes[i].mask & onMask; m; m &= m - 1) chart.Set((int)i, rowOf[CountTrailingZeros64(m)]);
+            if (opts.costModel != CostModel::Terms) chart.SetCost((int)i, TermCostUnder(PopCount32(primes[i].care), opts.costModel));
+        }
+        SolveCover(chart, opts, arena, result);
+        std::sort(result.cols.begin(), result.cols.end());
+        for (int col : result.cols) terms.push_back(primes[col]);
+    }
+    if (stats) *stats = result;
+}
+
+// --- 繪圖 ---
+// 不環繞的連續段：跨過邊界的框在邊界拆開
+static int Runs(uint32_t set, int size, uint8_t* start, uint8_t* length) {
+    int n = 0;
+    for (int i = 0; i < size;) {
+        if (!((set >> i) & 1)) { i++; continue; }
+        int j = i;
+        while (j < size && ((set >> j) & 1)) j++;
+        start[n] = (uint8_t)i;
+        length[n] = (uint8_t)(j - i);
+        n++;
+        i = j;
+    }
+    return n;
+}
+
+template <int N>
+int KMap<N>::Segments(uint32_t care, uint32_t value, KMapSegment* out) {
+    const uint32_t rowCare = care >> COL_VARS, rowValue = value >> COL_VARS;
+    const uint32_t colCare = care & (COLS - 1), colValue = value & (COLS - 1);
+    uint32_t rowSet = 0, colSet = 0;
+    for (int r = 0; r < ROWS; r++) if ((((uint32_t)Gray(r) ^ rowValue) & rowCare) == 0) rowSet |= 1u << r;
+    for (int c = 0; c < COLS; c++) if ((((uint32_t)Gray(c) ^ colValue) & colCare) == 0) colSet |= 1u << c;
+
+    uint8_t rowStart[ROWS], rowLength[ROWS], colStart[COLS], colLength[COLS];
+    int rowRuns = Runs(rowSet, ROWS, rowStart, rowLength);
+    int colRuns = Runs(colSet, COLS, colStart, colLength);
+    int n = 0;
+    for (int a = 0; a < colRuns; a++) for (int b = 0; b < rowRuns; b++) {
+        out[n++] = { colStart[a], rowStart[b], colLength[a], rowLength[b] };
+    }
+    return n;
+}
+
+template struct KMap<2>;
+template struct KMap<3>;
+template struct KMap<4>;
+template struct KMap<5>;
+template struct KMap<6>;
+
+// --- 執行期分派 ---
+// fn 收到對應實例的 KMap<N> (空物件，只用來取得型別)
+template <typename Fn>
+static bool Dispatch(int numVars, Fn fn) {
+    switch (numVars) {
+    case 2: fn(KMap<2>()); return true;
+    case 3: fn(KMap<3>()); return true;
+    case 4: fn(KMap<4>()); return true;
+    case 5: fn(KMap<5>()); return true;
+    case 6: fn(KMap<6>()); return true;
+    default: return false;
+    }
+}
+
+bool KMapShape(int numVars, int& rows, int& cols) {
+    return Dispatch(numVars, [&](auto map) {
+        rows = decltype(map)::ROWS;
+        cols = decltype(map)::COLS;
+    });
+}
+
+bool GridToMasksN(int numVars, const int* data, int targetVal, uint64_t& onMask, uint64_t& dcMask) {
+    return Dispatch(numVars, [&](auto map) {
+        typename decltype(map)::Mask on, dc;
+        decltype(map)::GridToMasks(data, targetVal, on, dc);
+        onMask = on;
+        dcMask = dc;
+    });
+}
+
+bool SolveKMapN(int numVars, uint64_t onMask, uint64_t dcMask, const CoverOptions& opts, std::vector<KMapTerm>& terms,
+                CoverResult* stats) {
+    return Dispatch(numVars, [&](auto map) {
+        typedef typename decltype(map)::Mask Mask;
+        decltype(map)::Solve((Mask)onMask, (Mask)dcMask, opts, terms, stats);
+    });
+}
+
+int KMapSegmentsN(int numVars, const KMapTerm& term, KMapSegment* out) {
+    int count = 0;
+    Dispatch(numVars, [&](auto map) { count = decltype(map)::Segments(term.care, term.value, out); });
+    return count;
+}
+
+// --- 字串生成 ---
+// 放不下的部分截斷，長度照算 (同 snprintf)
+struct TermWriter {
+    char* buf;
+    size_t size;
+    size_t length;
+
+    void Put(char c) {
+        if (length + 1 < size) buf[length] = c;
+        length++;
+    }
+    int Finish() {
+        if (size) buf[length < size ? length : size - 1] = '\0';
+        return (int)length;
+    }
+};
+
+static void WriteTermN(TermWriter& out, int numVars, const KMapTerm& term, bool isPOS) {
+    if (term.care == 0) { out.Put(isPOS ? '0' : '1'); return; }
+    if (isPOS) out.Put('(');
+    bool first = true;
+    for (int v = 0; v < numVars; v++) {
+        int bit = numVars - 1 - v;
+        if (((term.care >> bit) & 1) == 0) continue;
+        if (isPOS && !first) out.Put('+');
+        out.Put((char)('A' + v));
+        // POS 取補數：值為 1 的變數寫成 A'
+        bool positive = ((term.value >> bit) & 1) != 0;
+        if (positive == isPOS) out.Put('\'');
+        first = false;
+    }
+    if (isPOS) out.Put(')');
+}
+
+int FormatTermN(int numVars, const KMapTerm& term, bool isPOS, char* buf, size_t size) {
+    TermWriter out = { buf, size, 0 };
+    WriteTermN(out, numVars, term, isPOS);
+    return out.Finish();
+}
+
+std::string GenerateFormulaN(int numVars, const std::vector<KMapTerm>& terms, bool isPOS) {
+    if (terms.empty()) return isPOS ? "F = 1" : "F = 0";
+    std::string formula = "F = ";
+    char term[2 * KMAP_MAX_VARS + 8];
+    for (size_t i = 0; i < terms.size(); i++) {
+        FormatTermN(numVars, terms[i], isPOS, term, sizeof(term));
+        formula += term;
+        if (i < terms.size() - 1 && !isPOS) formula += " + ";
+    }
+    return formula;
+}
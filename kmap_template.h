@@ -0,0 +1,142 @@
+// N 變數卡諾圖 (N = 2..6) 的編譯期特化
+// 列為前 N/2 個變數、行為其餘變數，各自以 Gray code 排列 (N = 4 時即原本的 4x4，AB 為列、CD 為行)
+// 遮罩寬度、Gray code、環繞 (& (ROWS - 1) 取代 % 4) 都是編譯期常數，小的卡諾圖展開成直線的位元運算
+// 執行期才知道變數數時經由 SolveKMapN 等函數分派到對應的實例
+#ifndef KMAP_TEMPLATE_H
+#define KMAP_TEMPLATE_H
+
+#include "kmap_solver.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+const int KMAP_MIN_VARS = 2;
+const int KMAP_MAX_VARS = 6;
+
+// 格子遮罩：放得下 2^N 個位元的最小無號整數
+template <int N>
+using KMapMask = typename std::conditional<N <= 3, uint8_t,
+                 typename std::conditional<N == 4, uint16_t,
+                 typename std::conditional<N == 5, uint32_t, uint64_t>::type>::type>::type;
+
+// 與卡諾圖大小無關的乘積項：care 為出現的變數 (bit N-1 = A)，value 為各變數的值，mask 為覆蓋的格子
+struct KMapTerm {
+    uint32_t care;
+    uint32_t value;
+    uint64_t mask;
+};
+
+// 繪圖用的矩形 (單位為格)，環繞或不相鄰的框拆成數段
+struct KMapSegment {
+    uint8_t c, r, w, h;
+};
+
+template <int N>
+struct KMap {
+    static_assert(N >= KMAP_MIN_VARS && N <= KMAP_MAX_VARS, "KMap supports 2 to 6 variables");
+
+    typedef KMapMask<N> Mask;
+    static constexpr int ROW_VARS = N / 2;
+    static constexpr int COL_VARS = N - ROW_VARS;
+    static constexpr int ROWS = 1 << ROW_VARS;
+    static constexpr int COLS = 1 << COL_VARS;
+    static constexpr int CELLS = 1 << N;
+    static constexpr uint32_t VARS = (1u << N) - 1;
+    static constexpr Mask FULL = (Mask)(~0ull >> (64 - CELLS));
+    // 一列 (行) 中的格子最多分成 ROWS / 2 (COLS / 2) 段
+    static constexpr int MAX_SEGMENTS = (ROWS / 2) * (COLS / 2);
+
+    static constexpr int Gray(int i) { return i ^ (i >> 1); }
+    static constexpr int CellBit(int r, int c) { return (Gray(r) << COL_VARS) | Gray(c); }
+    static constexpr int WrapRow(int r) { return r & (ROWS - 1); }
+    static constexpr int WrapCol(int c) { return c & (COLS - 1); }
+
+    // 變數 v (minterm 的第 v 個位元) 為 1 的格子
+    static constexpr Mask VarCells(int v) { return (Mask)(TRUTH_VAR_MASKS[v] & FULL); }
+
+    static constexpr Mask CubeCells(uint32_t care, uint32_t value) {
+        Mask m = FULL;
+        for (int v = 0; v < N; v++) {
+            if ((care >> v) & 1) m &= ((value >> v) & 1) ? VarCells(v) : (Mask)~VarCells(v);
+        }
+        return m;
+    }
+
+    // 沿變數 v 的方向鏡射 (該變數反相後的格子)
+    static constexpr Mask FlipCells(Mask cells, int v) {
+        return (Mask)(((cells & VarCells(v)) >> (1 << v)) | ((cells & ~VarCells(v)) << (1 << v)));
+    }
+
+    static constexpr bool IsCovered(Mask cells, int r, int c) { return (cells >> CellBit(r, c)) & 1; }
+    static constexpr bool IsSubset(Mask sub, Mask super) { return (sub & ~super) == 0; }
+
+    // data 為 ROWS x COLS (row-major)
+    static void GridToMasks(const int* data, int targetVal, Mask& onMask, Mask& dcMask);
+
+    // 質項：不碰到非目標格、含目標格，且拿掉任一個字母都會碰到非目標格 (字母少的在前)
+    static void Primes(Mask onMask, Mask dcMask, std::vector<KMapTerm>& primes);
+
+    // opts 的覆蓋方法、預算與成本模型同 SolveKMapMask；結果依質項順序排列
+    static void Solve(Mask onMask, Mask dcMask, const CoverOptions& opts, std::vector<KMapTerm>& terms,
+                      CoverResult* stats = nullptr);
+
+    // 回傳段數 (<= MAX_SEGMENTS)
+    static int Segments(uint32_t care, uint32_t value, KMapSegment* out);
+};
+
+// 全部 3^N 個乘積項，字母少的在前 (同字母數時依 care、value 由小到大)，於編譯期產生
+template <int N>
+struct KMapCubeTable {
+    static constexpr int COUNT = N == 2 ? 9 : N == 3 ? 27 : N == 4 ? 81 : N == 5 ? 243 : 729;
+
+    uint8_t care[COUNT];
+    uint8_t value[COUNT];
+    KMapMask<N> cells[COUNT];
+
+    constexpr KMapCubeTable() : care{}, value{}, cells{} {
+        int n = 0;
+        for (int literals = 0; literals <= N; literals++) {
+            for (uint32_t c = 0; c <= KMap<N>::VARS; c++) {
+                int bits = 0;
+                for (int v = 0; v < N; v++) bits += (c >> v) & 1;
+                if (bits != literals) continue;
+                uint32_t v = 0;
+                do {
+                    care[n] = (uint8_t)c;
+                    value[n] = (uint8_t)v;
+                    cells[n] = KMap<N>::CubeCells(c, v);
+                    n++;
+                    v = (v - c) & c;
+                } while (v != 0);
+            }
+        }
+    }
+};
+
+template <int N>
+inline constexpr KMapCubeTable<N> KMAP_CUBES{};
+
+// 4 變數的實例必須與 IMPLICANT_TABLE 的格子配置相同
+constexpr bool KMap4MatchesImplicantTable() {
+    for (int r = 0; r < 4; r++) for (int c = 0; c < 4; c++) if (KMap<4>::CellBit(r, c) != CellBit(r, c)) return false;
+    for (const ImplicantRect& t : IMPLICANT_TABLE.rects) if (KMap<4>::CubeCells(t.care, t.value) != t.mask) return false;
+    return true;
+}
+
+static_assert(std::is_same<KMap<4>::Mask, CellMask>::value, "4-variable KMap must use CellMask");
+static_assert(KMap4MatchesImplicantTable(), "KMap<4> must agree with the implicant table");
+
+// --- 執行期分派 (numVars 不在 2..6 時回傳 false / 0) ---
+bool KMapShape(int numVars, int& rows, int& cols);
+bool GridToMasksN(int numVars, const int* data, int targetVal, uint64_t& onMask, uint64_t& dcMask);
+bool SolveKMapN(int numVars, uint64_t onMask, uint64_t dcMask, const CoverOptions& opts, std::vector<KMapTerm>& terms,
+                CoverResult* stats = nullptr);
+int KMapSegmentsN(int numVars, const KMapTerm& term, KMapSegment* out);
+
+// --- 字串生成 (A 為最高位的變數) ---
+int FormatTermN(int numVars, const KMapTerm& term, bool isPOS, char* buf, size_t size);
+std::string GenerateFormulaN(int numVars, const std::vector<KMapTerm>& terms, bool isPOS);
+
+#endif // KMAP_TEMPLATE_H
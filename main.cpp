@@ -1,222 +1,36 @@
 ﻿#include "raylib.h"
 #include "font_data.h"
 #include "icon_data.h"
+#include "kmap_solver.h"
+#include "solver_worker.h"
+#include "verifier.h"
 #include <cmath>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <cstring> // For memcpy
 
-// --- 定義常數 ---
-const int VAL_0 = 0;
-const int VAL_1 = 1;
-const int VAL_X = 2; // Don't Care
-
-// --- 資料結構 ---
-struct KMapGroup {
-    int r, c, h, w;
-    Color color;
-    bool operator==(const KMapGroup& other) const {
-        return r == other.r && c == other.c && h == other.h && w == other.w;
-    }
-};
-
 // 用於 Undo 的狀態快照
 struct GridState {
     int data[4][4];
 };
 
-const int GRAY_CODES[] = { 0, 1, 3, 2 }; 
 const char* ROW_LABELS[] = { "00", "01", "11", "10" };
 const char* COL_LABELS[] = { "00", "01", "11", "10" };
 
-Color GROUP_COLORS[] = {
-    { 255, 0, 127, 255 }, { 0, 255, 255, 255 },
-    { 255, 255, 0, 255 }, { 155, 89, 182, 255 },
-    { 255, 128, 0, 255 }, { 0, 255, 128, 255 }
-};
-
-// --- 輔助函數 ---
-bool IsCovered(const KMapGroup& g, int r, int c) {
-    int dr = (r - g.r + 4) % 4;
-    int dc = (c - g.c + 4) % 4;
-    return (dr < g.h && dc < g.w);
-}
-
-bool IsSubset(const KMapGroup& sub, const KMapGroup& super) {
-    for (int i = 0; i < sub.h; i++) {
-        for (int j = 0; j < sub.w; j++) {
-            int r = (sub.r + i) % 4;
-            int c = (sub.c + j) % 4;
-            if (!IsCovered(super, r, c)) return false;
-        }
-    }
-    return true;
-}
-
-// --- 框框核心演算法 ---3
-std::vector<KMapGroup> SolveKMap(int data[4][4], int targetVal) {
-    std::vector<KMapGroup> candidates;
-    int shapes[][2] = { {4,4}, {2,4}, {4,2}, {1,4}, {4,1}, {2,2}, {1,2}, {2,1}, {1,1} };
-    for (auto& shape : shapes) {
-        int h = shape[0];
-        int w = shape[1];
-        int maxR = (h == 4) ? 1 : 4;
-        int maxC = (w == 4) ? 1 : 4;
-        for (int r = 0; r < maxR; r++) {
-            for (int c = 0; c < maxC; c++) {
-                bool isValidGroup = true;
-                bool containsTarget = false;
-                for (int i = 0; i < h; i++) {
-                    for (int j = 0; j < w; j++) {
-                        int val = data[(r + i) % 4][(c + j) % 4];
-                        if (val != targetVal && val != VAL_X) { isValidGroup = false; break; }
-                        if (val == targetVal) containsTarget = true;
-                    }
-                    if (!isValidGroup) break;
-                }
-                if (isValidGroup && containsTarget) candidates.push_back({r, c, h, w, WHITE});
-            }
-        }
-    }
-
-    std::vector<KMapGroup> PIs;
-    for (size_t i = 0; i < candidates.size(); i++) {
-        bool shouldRemove = false;
-        for (size_t j = 0; j < candidates.size(); j++) {
-            if (i == j) continue;
-            bool i_in_j = IsSubset(candidates[i], candidates[j]);
-            bool j_in_i = IsSubset(candidates[j], candidates[i]);
-            if (i_in_j && j_in_i) { if (i > j) { shouldRemove = true; break; } } 
-            else if (i_in_j) { shouldRemove = true; break; }
-        }
-        if (!shouldRemove) PIs.push_back(candidates[i]);
-    }
-
-    std::vector<KMapGroup> solution;
-    bool cellCovered[4][4] = {false};
-    int targetCount = 0;
-    for(int r=0; r<4; r++) for(int c=0; c<4; c++) 
-        if(data[r][c] != targetVal) cellCovered[r][c] = true; else targetCount++;
-
-    if (targetCount == 0) return solution;
-
-    for (int r = 0; r < 4; r++) {
-        for (int c = 0; c < 4; c++) {
-            if (data[r][c] == targetVal) {
-                KMapGroup* uniqueCover = nullptr;
-                int coverCount = 0;
-                for (auto& pi : PIs) {
-                    if (IsCovered(pi, r, c)) { coverCount++; uniqueCover = &pi; }
-                }
-                if (coverCount == 1 && uniqueCover != nullptr) {
-                    bool alreadyAdded = false;
-                    for(auto& s : solution) if(s == *uniqueCover) alreadyAdded = true;
-                    if (!alreadyAdded) solution.push_back(*uniqueCover);
-                }
-            }
-        }
-    }
-
-    for (auto& s : solution) {
-        for (int i = 0; i < s.h; i++) for (int j = 0; j < s.w; j++)
-            cellCovered[(s.r + i) % 4][(s.c + j) % 4] = true;
-    }
-
-    while (true) {
-        int maxUncovered = 0;
-        int bestPIIdx = -1;
-        for (size_t i = 0; i < PIs.size(); i++) {
-            bool inSol = false;
-            for(auto& s : solution) if(s == PIs[i]) inSol = true;
-            if(inSol) continue;
-            int newCover = 0;
-            for (int row = 0; row < PIs[i].h; row++) {
-                for (int col = 0; col < PIs[i].w; col++) {
-                    int r = (PIs[i].r + row) % 4;
-                    int c = (PIs[i].c + col) % 4;
-                    if (!cellCovered[r][c] && data[r][c] == targetVal) newCover++;
-                }
-            }
-            if (newCover > maxUncovered) { maxUncovered = newCover; bestPIIdx = i; }
-        }
-        if (maxUncovered == 0) break;
-        solution.push_back(PIs[bestPIIdx]);
-        for (int i = 0; i < PIs[bestPIIdx].h; i++) for (int j = 0; j < PIs[bestPIIdx].w; j++)
-            cellCovered[(PIs[bestPIIdx].r + i) % 4][(PIs[bestPIIdx].c + j) % 4] = true;
-    }
-
-    for(size_t i=0; i<solution.size(); i++) solution[i].color = GROUP_COLORS[i % 6];
-    return solution;
-}
-
-// --- 字串生成 ---
-std::string GetTerm(const KMapGroup& g, bool isPOS) {
-    if (g.h == 4 && g.w == 4) return isPOS ? "0" : "1";
-    int rowAnd = 0b11, rowOr = 0b00;
-    for (int i = 0; i < g.h; i++) {
-        int code = GRAY_CODES[(g.r + i) % 4]; 
-        rowAnd &= code; rowOr |= code;
-    }
-    int colAnd = 0b11, colOr = 0b00;
-    for (int j = 0; j < g.w; j++) {
-        int code = GRAY_CODES[(g.c + j) % 4]; 
-        colAnd &= code; colOr |= code;
-    }
-    std::vector<std::string> literals;
-    if ((rowAnd & 2) != 0) literals.push_back(isPOS ? "A'" : "A");
-    else if ((rowOr & 2) == 0) literals.push_back(isPOS ? "A" : "A'");
-    if ((rowAnd & 1) != 0) literals.push_back(isPOS ? "B'" : "B");
-    else if ((rowOr & 1) == 0) literals.push_back(isPOS ? "B" : "B'");
-    if ((colAnd & 2) != 0) literals.push_back(isPOS ? "C'" : "C");
-    else if ((colOr & 2) == 0) literals.push_back(isPOS ? "C" : "C'");
-    if ((colAnd & 1) != 0) literals.push_back(isPOS ? "D'" : "D");
-    else if ((colOr & 1) == 0) literals.push_back(isPOS ? "D" : "D'");
-
-    std::string term = "";
-    if (isPOS) {
-        term += "(";
-        for (size_t i = 0; i < literals.size(); i++) {
-            term += literals[i];
-            if (i < literals.size() - 1) term += "+";
-        }
-        term += ")";
-    } else {
-        for (const auto& s : literals) term += s;
-    }
-    return term;
-}
-
-std::string GenerateFormula(const std::vector<KMapGroup>& groups, bool isPOS) {
-    if (groups.empty()) return isPOS ? "F = 1" : "F = 0";
-    std::string formula = "F = ";
-    for (size_t i = 0; i < groups.size(); i++) {
-        formula += GetTerm(groups[i], isPOS);
-        if (i < groups.size() - 1) formula += (isPOS ? "" : " + "); 
-    }
-    return formula;
-}
-
 // --- 繪圖函數 ---
 void DrawWrappedGroup(KMapGroup g, int startX, int startY, int cellSize, float alpha, bool isPOS) {
-    std::vector<std::pair<int, int>> hSegments; 
-    if (g.c + g.w <= 4) hSegments.push_back({g.c, g.w});
-    else { hSegments.push_back({g.c, 4 - g.c}); hSegments.push_back({0, g.w - (4 - g.c)}); }
-
-    std::vector<std::pair<int, int>> vSegments; 
-    if (g.r + g.h <= 4) vSegments.push_back({g.r, g.h});
-    else { vSegments.push_back({g.r, 4 - g.r}); vSegments.push_back({0, g.h - (4 - g.r)}); }
-
-    for (auto& hSeg : hSegments) {
-        for (auto& vSeg : vSegments) {
-            Rectangle rect = { (float)startX + hSeg.first * cellSize + 5, (float)startY + vSeg.first * cellSize + 5, (float)hSeg.second * cellSize - 10, (float)vSeg.second * cellSize - 10 };
-            DrawRectangleRoundedLines(rect, 0.2f, 6, Fade(g.color, alpha + 0.2f));
-            DrawRectangleRounded(rect, 0.2f, 6, Fade(g.color, 0.1f));
-        }
+    const ImplicantRect& t = IMPLICANT_TABLE.rects[g.rect];
+    for (int k = 0; k < t.segCount; k++) {
+        const uint8_t* seg = t.seg[k];
+        Rectangle rect = { (float)startX + seg[0] * cellSize + 5, (float)startY + seg[1] * cellSize + 5, (float)seg[2] * cellSize - 10, (float)seg[3] * cellSize - 10 };
+        DrawRectangleRoundedLines(rect, 0.2f, 6, Fade(g.color, alpha + 0.2f));
+        DrawRectangleRounded(rect, 0.2f, 6, Fade(g.color, 0.1f));
     }
     Rectangle mainRect = { (float)startX + g.c * cellSize + 5, (float)startY + g.r * cellSize + 5, 40, 30 };
-    std::string term = GetTerm(g, isPOS);
-    DrawText(term.c_str(), (int)mainRect.x + 5, (int)mainRect.y + 5, 20, g.color);
+    char term[TERM_BUFFER_SIZE];
+    FormatTerm(g, isPOS, term, sizeof(term));
+    DrawText(term, (int)mainRect.x + 5, (int)mainRect.y + 5, 20, g.color);
 }
 
 void DrawNeonCell(int r, int c, int startX, int startY, int cellSize, int value, Font font, bool isHovered, bool showIndex, bool isPOS) {
@@ -347,6 +161,8 @@ void SaveHistory(std::vector<GridState>& history, int data[4][4]) {
     if (history.size() > 50) history.erase(history.begin());
 }
 
+const size_t MAX_ALTERNATIVES = 64; // N 鍵循環顯示的最低成本解數量上限
+
 int main() {
     SetConfigFlags(FLAG_MSAA_4X_HINT);
     InitWindow(1000, 800, "K-Map Solver");
@@ -370,11 +186,23 @@ int main() {
     // 歷史紀錄堆疊
     std::vector<GridState> history;
 
+    // 4 變數的質項表很小，直接用精確覆蓋取得最少項數
+    CoverOptions solveOpts;
+    solveOpts.method = CoverMethod::Exact;
+    // 化簡在背景執行緒進行 (拖曳時質項局部更新)，畫面先沿用上一次的 groups
+    // 有預先計算的解答庫 (NpnGen 產生) 時精確模式直接查表
+    NpnDatabase npnDatabase;
+    SolverWorker solver;
+    if (npnDatabase.Open("kmap_npn.bin")) solver.SetDatabase(&npnDatabase);
+
     int startX = 250, startY = 200, cellSize = 100;
     
     bool showIndexMode = false;
     bool showBarMode = false;
     bool isPOSMode = false;
+    bool autoFormMode = false; // SOP / POS 同時化簡，顯示成本較低的一邊 (格子以 1 為 on-set)
+    int alternativeIndex = -1; // 目前顯示第幾個最低成本解 (-1 = 化簡器的結果)
+    int alternativeCount = 0;  // 上次按 N 時找到的最低成本覆蓋數
 
     float copyFeedbackTimer = 0.0f;
     float undoFeedbackTimer = 0.0f; // 顯示 Undo 提示
@@ -410,6 +238,19 @@ int main() {
 
         bool needSolve = false;
 
+        // L：切換成本模型 (項數 / 字母數 / 閘輸入數)
+        if (IsKeyPressed(KEY_L)) {
+            if (solveOpts.costModel == CostModel::Terms) solveOpts.costModel = CostModel::Literals;
+            else if (solveOpts.costModel == CostModel::Literals) solveOpts.costModel = CostModel::GateInputs;
+            else solveOpts.costModel = CostModel::Terms;
+            needSolve = true;
+        }
+        // B：切換精確覆蓋的後端 (分支界限 / SAT)
+        if (IsKeyPressed(KEY_B)) {
+            solveOpts.method = solveOpts.method == CoverMethod::Exact ? CoverMethod::Sat : CoverMethod::Exact;
+            needSolve = true;
+        }
+
         int hoverR = -1, hoverC = -1;
         for (int r = 0; r < 4; r++) {
             for (int c = 0; c < 4; c++) {
@@ -429,13 +270,19 @@ int main() {
             else if (CheckCollisionPointRec(mousePos, { 800, 220, 150, 40 })) showBarMode = !showBarMode;
             else if (CheckCollisionPointRec(mousePos, { 800, 280, 150, 40 })) triggerCopy = true;
             else if (CheckCollisionPointRec(mousePos, { 800, 340, 150, 40 })) {
-                // 存檔 (Mode Switch)
+                // 存檔 (Mode Switch)：SOP -> POS -> Auto -> SOP
                 SaveHistory(history, data);
-                
-                isPOSMode = !isPOSMode;
-                for(int r=0; r<4; r++) for(int c=0; c<4; c++) {
-                    if (data[r][c] == VAL_0) data[r][c] = VAL_1;
-                    else if (data[r][c] == VAL_1) data[r][c] = VAL_0;
+
+                if (autoFormMode) {
+                    autoFormMode = false;
+                    isPOSMode = false;
+                } else {
+                    isPOSMode = !isPOSMode;
+                    for(int r=0; r<4; r++) for(int c=0; c<4; c++) {
+                        if (data[r][c] == VAL_0) data[r][c] = VAL_1;
+                        else if (data[r][c] == VAL_1) data[r][c] = VAL_0;
+                    }
+                    if (!isPOSMode) autoFormMode = true;
                 }
                 needSolve = true;
             }
@@ -494,7 +341,7 @@ int main() {
 
         if (triggerClear) {
             SaveHistory(history, data); // 存檔 (Clear)
-            int fillValue = isPOSMode ? VAL_1 : VAL_0;
+            int fillValue = (isPOSMode && !autoFormMode) ? VAL_1 : VAL_0;
             for(int r=0; r<4; r++) for(int c=0; c<4; c++) data[r][c] = fillValue;
             needSolve = true;
         }
@@ -509,7 +356,43 @@ int main() {
             }
         }
 
-        if (needSolve) groups = SolveKMap(data, isPOSMode ? VAL_0 : VAL_1);
+        if (needSolve) {
+            if (autoFormMode) solver.SubmitDual(data, solveOpts);
+            else solver.Submit(data, isPOSMode ? VAL_0 : VAL_1, solveOpts);
+        }
+        bool resultIsPOS = false;
+        if (solver.Poll(groups, nullptr, &resultIsPOS)) {
+            if (autoFormMode) isPOSMode = resultIsPOS;
+            alternativeIndex = -1;
+        }
+
+        // N：同一個格子的其他最低成本解 (依序循環)
+        if (IsKeyPressed(KEY_N) && !solver.Busy()) {
+            CellMask onMask, dcMask;
+            GridToMasks(data, isPOSMode ? VAL_0 : VAL_1, onMask, dcMask);
+            KMapSolutionEnumerator enumerator(onMask, dcMask, solveOpts, MAX_ALTERNATIVES);
+            std::vector<std::vector<KMapGroup>> alternatives;
+            std::vector<KMapGroup> alt;
+            while (enumerator.Next(alt)) {
+                if (CheckKMapSolve(alt.data(), alt.size(), onMask, dcMask, "alternatives")) alternatives.push_back(alt);
+            }
+
+            // 從目前顯示的解換到下一個
+            std::vector<int> current;
+            for (const KMapGroup& g : groups) current.push_back(g.rect);
+            std::sort(current.begin(), current.end());
+            int found = -1;
+            for (size_t i = 0; i < alternatives.size() && found < 0; i++) {
+                std::vector<int> rects;
+                for (const KMapGroup& g : alternatives[i]) rects.push_back(g.rect);
+                if (rects == current) found = (int)i;
+            }
+            alternativeCount = (int)alternatives.size();
+            if (alternativeCount > 0) {
+                alternativeIndex = (found + 1) % alternativeCount;
+                groups = alternatives[alternativeIndex];
+            }
+        }
 
         // --- Drawing ---
         BeginDrawing();
@@ -550,7 +433,8 @@ int main() {
             Color btnFmtColor = ORANGE;
             DrawRectangleRounded({ 800, 340, 150, 40 }, 0.3f, 4, Fade(btnFmtColor, 0.3f));
             DrawRectangleRoundedLines({ 800, 340, 150, 40 }, 0.3f, 4, btnFmtColor);
-            DrawTextEx(techFont, isPOSMode ? "Format: POS" : "Format: SOP", {820, 348}, 20, 0, WHITE);
+            if (autoFormMode) DrawTextEx(techFont, isPOSMode ? "Auto: POS" : "Auto: SOP", {830, 348}, 20, 0, WHITE);
+            else DrawTextEx(techFont, isPOSMode ? "Format: POS" : "Format: SOP", {820, 348}, 20, 0, WHITE);
             
             // Undo Tip / Feedback
             if (undoFeedbackTimer > 0) {
@@ -560,6 +444,21 @@ int main() {
             }
             DrawTextEx(techFont, "Drag: 1 / [Shift]: 0", {805, 430}, 15, 0, GRAY);
             DrawTextEx(techFont, "[X]+Drag: X", {805, 450}, 15, 0, GRAY);
+            if (alternativeIndex >= 0) {
+                DrawTextEx(techFont, TextFormat("[N] Solution %d/%d", alternativeIndex + 1, alternativeCount), {805, 500}, 15, 0, SKYBLUE);
+            } else {
+                DrawTextEx(techFont, "[N] Alternatives", {805, 500}, 15, 0, GRAY);
+            }
+            FormCost cost = GroupCost(groups.data(), groups.size());
+            DrawTextEx(techFont, TextFormat("[L] %s: %d", CostModelName(solveOpts.costModel), cost.Total(solveOpts.costModel)),
+                       {805, 480}, 15, 0, YELLOW);
+            DrawTextEx(techFont, solveOpts.method == CoverMethod::Sat ? "[B] Exact: SAT" : "[B] Exact: B&B", {805, 540}, 15, 0,
+                       GRAY);
+            VerifyCounters verify = SolveVerifyCounters();
+            if (verify.failed > 0) {
+                DrawTextEx(techFont, TextFormat("Verify failed: %llu/%llu", (unsigned long long)verify.failed,
+                                                (unsigned long long)verify.checked), {805, 520}, 15, 0, RED);
+            }
 
             for (int r = 0; r < 4; r++) {
                 for (int c = 0; c < 4; c++) {
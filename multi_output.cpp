@@ -0,0 +1,208 @@
+#include "multi_output.h"
+#include "bit_utils.h"
+#include "kmap_solver.h"
+#include <algorithm>
+#include <unordered_map>
+
+// 每個 minterm 在哪些輸出的 on ∪ dc (care) 與 on 之中
+struct OutputMasks {
+    std::vector<uint32_t> care, on;
+};
+
+static OutputMasks BuildMasks(int numInputs, const std::vector<std::vector<uint32_t>>& onSets,
+                              const std::vector<std::vector<uint32_t>>& dcSets) {
+    const uint32_t varMask = (uint32_t)((1ull << numInputs) - 1);
+    OutputMasks masks;
+    masks.care.assign((size_t)1 << numInputs, 0);
+    masks.on.assign((size_t)1 << numInputs, 0);
+    for (size_t o = 0; o < onSets.size(); o++) {
+        for (uint32_t m : onSets[o]) if ((m & ~varMask) == 0) { masks.on[m] |= 1u << o; masks.care[m] |= 1u << o; }
+    }
+    for (size_t o = 0; o < dcSets.size() && o < onSets.size(); o++) {
+        for (uint32_t m : dcSets[o]) if ((m & ~varMask) == 0) masks.care[m] |= 1u << o;
+    }
+    return masks;
+}
+
+// 逐一列舉乘積項中的 minterm
+template <typename Body>
+static void ForEachMinterm(const Implicant& p, Body body) {
+    uint32_t sub = 0;
+    do {
+        body(p.value | sub);
+        sub = (sub - p.mask) & p.mask;
+    } while (sub != 0);
+}
+
+// 帶標記的 QM：兩項合併後的標記為兩者標記的交集 (不為空才合併)
+// 一項的標記整個傳給合併結果時，它對這些輸出都不是最大的乘積項，不再是質項
+static std::vector<MultiOutputTerm> PrimesFromMasks(int numInputs, const std::vector<uint32_t>& care) {
+    struct Entry {
+        uint32_t tag;
+        bool covered;
+    };
+    const uint32_t varMask = (uint32_t)((1ull << numInputs) - 1);
+    std::vector<MultiOutputTerm> primes;
+    std::unordered_map<uint64_t, Entry> cur;
+    for (uint32_t m = 0; m <= varMask; m++) if (care[m]) cur[Implicant{ m, 0 }.Key()] = { care[m], false };
+
+    while (!cur.empty()) {
+        std::unordered_map<uint64_t, Entry> next;
+        for (auto& item : cur) {
+            const Implicant a = { (uint32_t)item.first, (uint32_t)(item.first >> 32) };
+            uint32_t free = varMask & ~a.mask & ~a.value;
+            while (free) {
+                uint32_t bit = free & (0u - free);
+                free &= free - 1;
+                auto partner = cur.find(Implicant{ a.value | bit, a.mask }.Key());
+                if (partner == cur.end()) continue;
+                const uint32_t tag = item.second.tag & partner->second.tag;
+                if (!tag) continue;
+                next[Implicant{ a.value, a.mask | bit }.Key()] = { tag, false };
+                if (tag == item.second.tag) item.second.covered = true;
+                if (tag == partner->second.tag) partner->second.covered = true;
+            }
+        }
+        for (const auto& item : cur) {
+            if (!item.second.covered) primes.push_back({ { (uint32_t)item.first, (uint32_t)(item.first >> 32) }, item.second.tag });
+        }
+        cur.swap(next);
+    }
+    // hash 的走訪順序不固定，排序後輸出與實作無關
+    std::sort(primes.begin(), primes.end(),
+              [](const MultiOutputTerm& x, const MultiOutputTerm& y) { return x.term.Key() < y.term.Key(); });
+    return primes;
+}
+
+static bool ValidShape(int numInputs, size_t numOutputs) {
+    return numInputs >= QM_MIN_VARS && numInputs <= QM_MAX_VARS && numOutputs >= 1 &&
+           numOutputs <= (size_t)MULTI_OUTPUT_MAX_OUTPUTS;
+}
+
+std::vector<MultiOutputTerm> GenerateMultiOutputPrimes(int numInputs, const std::vector<std::vector<uint32_t>>& onSets,
+                                                       const std::vector<std::vector<uint32_t>>& dcSets) {
+    if (!ValidShape(numInputs, onSets.size())) return std::vector<MultiOutputTerm>();
+    return PrimesFromMasks(numInputs, BuildMasks(numInputs, onSets, dcSets).care);
+}
+
+MultiOutputResult SolveMultiOutput(int numInputs, const std::vector<std::vector<uint32_t>>& onSets,
+                                   const std::vector<std::vector<uint32_t>>& dcSets, const CoverOptions& opts) {
+    MultiOutputResult result;
+    result.stats.optimal = true;
+    if (!ValidShape(numInputs, onSets.size())) return result;
+    result.numOutputs = (int)onSets.size();
+    const OutputMasks masks = BuildMasks(numInputs, onSets, dcSets);
+
+    // 列 = (輸出, on-set minterm)：minterm m 的列從 rowBase[m] 開始，依輸出編號排列
+    std::vector<uint32_t> rowBase(masks.on.size());
+    uint32_t numRows = 0;
+    for (size_t m = 0; m < masks.on.size(); m++) {
+        rowBase[m] = numRows;
+        numRows += (uint32_t)PopCount32(masks.on[m]);
+    }
+    if (numRows == 0) return result;
+    auto rowOf = [&](uint32_t m, int o) { return rowBase[m] + (uint32_t)PopCount32(masks.on[m] & ((1u << o) - 1)); };
+
+    // 只留下至少對一個輸出覆蓋到 on-set 的質項
+    for (const MultiOutputTerm& p : PrimesFromMasks(numInputs, masks.care)) {
+        uint32_t useful = 0;
+        ForEachMinterm(p.term, [&](uint32_t m) { useful |= masks.on[m] & p.outputs; });
+        if (useful) result.primes.push_back(p);
+    }
+
+    CoverProblem chart;
+    chart.Init((int)numRows, (int)result.primes.size());
+    for (size_t c = 0; c < result.primes.size(); c++) {
+        const MultiOutputTerm& p = result.primes[c];
+        ForEachMinterm(p.term, [&](uint32_t m) {
+            for (uint32_t outs = masks.on[m] & p.outputs; outs; outs &= outs - 1) {
+                chart.Set((int)c, (int)rowOf(m, CountTrailingZeros64(outs)));
+            }
+        });
+        if (opts.costModel != CostModel::Terms) {
+            int literals = numInputs - PopCount32(p.term.mask);
+            chart.SetCost((int)c, TermCostUnder(literals, opts.costModel));
+        }
+    }
+    result.stats = SolveCover(chart, opts);
+
+    // 選中的項先接到所有它覆蓋到 on-set 的輸出，再由後往前拿掉各輸出中多餘的連線
+    std::vector<int> rowCount(numRows, 0);
+    std::vector<MultiOutputTerm> chosen;
+    for (int c : result.stats.cols) {
+        MultiOutputTerm t = { result.primes[c].term, 0 };
+        ForEachMinterm(t.term, [&](uint32_t m) { t.outputs |= masks.on[m] & result.primes[c].outputs; });
+        ForEachMinterm(t.term, [&](uint32_t m) {
+            for (uint32_t outs = masks.on[m] & t.outputs; outs; outs &= outs - 1) rowCount[rowOf(m, CountTrailingZeros64(outs))]++;
+        });
+        chosen.push_back(t);
+    }
+    for (size_t i = chosen.size(); i-- > 0;) {
+        MultiOutputTerm& t = chosen[i];
+        for (uint32_t outs = t.outputs; outs; outs &= outs - 1) {
+            const int o = CountTrailingZeros64(outs);
+            bool needed = false;
+            ForEachMinterm(t.term, [&](uint32_t m) {
+                if (((masks.on[m] >> o) & 1) && rowCount[rowOf(m, o)] < 2) needed = true;
+            });
+            if (needed) continue;
+            ForEachMinterm(t.term, [&](uint32_t m) {
+                if ((masks.on[m] >> o) & 1) rowCount[rowOf(m, o)]--;
+            });
+            t.outputs &= ~(1u << o);
+        }
+    }
+
+    // 不再接到任何輸出的項一併從覆蓋結果中移除
+    std::vector<int> cols;
+    result.stats.cost = 0;
+    for (size_t i = 0; i < chosen.size(); i++) {
+        if (!chosen[i].outputs) continue;
+        result.terms.push_back(chosen[i]);
+        cols.push_back(result.stats.cols[i]);
+        result.stats.cost += chart.Cost(result.stats.cols[i]);
+    }
+    result.stats.cols.swap(cols);
+    return result;
+}
+
+std::vector<Implicant> MultiOutputResult::OutputCover(int o) const {
+    std::vector<Implicant> cover;
+    for (const MultiOutputTerm& t : terms) if ((t.outputs >> o) & 1) cover.push_back(t.term);
+    return cover;
+}
+
+int MultiOutputResult::SharedTerms() const {
+    int shared = 0;
+    for (const MultiOutputTerm& t : terms) if (PopCount32(t.outputs) > 1) shared++;
+    return shared;
+}
+
+int MultiOutputResult::Connections() const {
+    int connections = 0;
+    for (const MultiOutputTerm& t : terms) connections += PopCount32(t.outputs);
+    return connections;
+}
+
+// --- 字串生成 ---
+std::string GenerateMultiOutputFormulas(const MultiOutputResult& result, int numInputs, bool isPOS) {
+    std::string text;
+    for (int o = 0; o < result.numOutputs; o++) {
+        // GenerateQMFormula 以 "F = " 開頭，換成輸出名稱
+        std::string formula = GenerateQMFormula(result.OutputCover(o), numInputs, isPOS);
+        if (o > 0) text += "\n";
+        text += "F" + std::to_string(o) + formula.substr(1);
+    }
+    return text;
+}
+
+std::string GenerateSharedTermTable(const MultiOutputResult& result, int numInputs, bool isPOS) {
+    std::string text;
+    for (size_t i = 0; i < result.terms.size(); i++) {
+        const MultiOutputTerm& t = result.terms[i];
+        if (i > 0) text += "\n";
+        text += "P" + std::to_string(i + 1) + " = " + GetImplicantTerm(t.term, numInputs, isPOS) + " :";
+        for (uint32_t outs = t.outputs; outs; outs &= outs - 1) text += " F" + std::to_string(CountTrailingZeros64(outs));
+    }
+    return text;
+}
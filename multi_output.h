@@ -0,0 +1,51 @@
+// 多輸出化簡：同一組輸入的多個輸出 (最多 32 個) 一起化簡，讓乘積項在輸出間共用 (PLA 的 AND 平面只需一份)
+// 每個乘積項帶有輸出標記 (可以使用此項的輸出集合)，以帶標記的 Quine-McCluskey 一次產生所有多輸出質項，
+// 再以所有 (輸出, on-set minterm) 為列共同求覆蓋
+#ifndef MULTI_OUTPUT_H
+#define MULTI_OUTPUT_H
+
+#include "cover.h"
+#include "qm.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const int MULTI_OUTPUT_MAX_OUTPUTS = 32;
+
+struct MultiOutputTerm {
+    Implicant term;
+    uint32_t outputs; // 第 o 個位元 = 第 o 個輸出 (質項列表中為可以使用此項的輸出，覆蓋中為實際接上的輸出)
+};
+
+struct MultiOutputResult {
+    int numOutputs = 0;
+    std::vector<MultiOutputTerm> primes; // 至少對一個輸出覆蓋到 on-set 的多輸出質項
+    std::vector<MultiOutputTerm> terms;  // 選中的乘積項 (每項只出現一次)
+    CoverResult stats;                   // 覆蓋引擎的結果 (cost 為共用後的總成本)
+
+    // 第 o 個輸出使用的乘積項 (依 terms 的順序)
+    std::vector<Implicant> OutputCover(int o) const;
+    // 接到兩個以上輸出的乘積項數
+    int SharedTerms() const;
+    // OR 平面的連線數 (每個乘積項接到的輸出數總和)
+    int Connections() const;
+};
+
+// 多輸出質項：(c, T) 中 T 為 c 整個落在 on ∪ dc 內的輸出集合，且沒有更大的乘積項對 T 中所有輸出都成立
+// onSets[o] / dcSets[o] 為第 o 個輸出的 minterm (dcSets 可以比 onSets 短)，超出範圍的 minterm 會被忽略
+std::vector<MultiOutputTerm> GenerateMultiOutputPrimes(int numInputs, const std::vector<std::vector<uint32_t>>& onSets,
+                                                       const std::vector<std::vector<uint32_t>>& dcSets);
+
+// 1–QM_MAX_VARS 個輸入、1–32 個輸出；opts.costModel 為每個乘積項的成本 (共用的項只算一次)
+// 覆蓋後每個輸出再各自拿掉多餘的連線，POS 時傳入各輸出 0 的 minterm
+MultiOutputResult SolveMultiOutput(int numInputs, const std::vector<std::vector<uint32_t>>& onSets,
+                                   const std::vector<std::vector<uint32_t>>& dcSets,
+                                   const CoverOptions& opts = CoverOptions());
+
+// --- 字串生成 ---
+// 每個輸出一行，格式同 GenerateQMFormula ("F0 = AB' + C")
+std::string GenerateMultiOutputFormulas(const MultiOutputResult& result, int numInputs, bool isPOS);
+// 共用乘積項表：每項一行 ("P1 = AB'C : F0 F2")
+std::string GenerateSharedTermTable(const MultiOutputResult& result, int numInputs, bool isPOS);
+
+#endif // MULTI_OUTPUT_H
@@ -0,0 +1,229 @@
+#include "npn_database.h"
+#include <cstdio>
+#include <cstring>
+
+// --- 轉換表 ---
+// 轉換 t = perm * 16 + neg：minterm 的第 i 個位元先與 neg 互斥，再搬到第 PERMS[perm][i] 個位元
+struct NpnTables {
+    uint16_t lo[NPN_TRANSFORM_COUNT][256]; // 遮罩低 8 位元的轉換結果
+    uint16_t hi[NPN_TRANSFORM_COUNT][256]; // 遮罩高 8 位元的轉換結果
+    int inverse[NPN_TRANSFORM_COUNT];
+    uint8_t rectMap[NPN_TRANSFORM_COUNT][IMPLICANT_COUNT];
+
+    NpnTables() {
+        int perms[24][4];
+        int count = 0;
+        for (int a = 0; a < 4; a++) for (int b = 0; b < 4; b++) for (int c = 0; c < 4; c++) for (int d = 0; d < 4; d++) {
+            if (a == b || a == c || a == d || b == c || b == d || c == d) continue;
+            perms[count][0] = a; perms[count][1] = b; perms[count][2] = c; perms[count][3] = d;
+            count++;
+        }
+
+        static int cellMap[NPN_TRANSFORM_COUNT][16];
+        for (int t = 0; t < NPN_TRANSFORM_COUNT; t++) {
+            const int* p = perms[t / 16];
+            int neg = t % 16;
+            for (int m = 0; m < 16; m++) {
+                int x = m ^ neg, y = 0;
+                for (int i = 0; i < 4; i++) if ((x >> i) & 1) y |= 1 << p[i];
+                cellMap[t][m] = y;
+            }
+            for (int v = 0; v < 256; v++) {
+                uint16_t l = 0, h = 0;
+                for (int b = 0; b < 8; b++) {
+                    if ((v >> b) & 1) {
+                        l = (uint16_t)(l | (1u << cellMap[t][b]));
+                        h = (uint16_t)(h | (1u << cellMap[t][b + 8]));
+                    }
+                }
+                lo[t][v] = l;
+                hi[t][v] = h;
+            }
+        }
+
+        for (int t = 0; t < NPN_TRANSFORM_COUNT; t++) {
+            for (int u = 0; u < NPN_TRANSFORM_COUNT; u++) {
+                bool identity = true;
+                for (int m = 0; m < 16 && identity; m++) identity = cellMap[u][cellMap[t][m]] == m;
+                if (identity) { inverse[t] = u; break; }
+            }
+            for (int r = 0; r < IMPLICANT_COUNT; r++) {
+                CellMask mask = IMPLICANT_TABLE.rects[r].mask;
+                CellMask mapped = (CellMask)(lo[t][mask & 0xFF] | hi[t][mask >> 8]);
+                for (int s = 0; s < IMPLICANT_COUNT; s++) {
+                    if (IMPLICANT_TABLE.rects[s].mask == mapped) { rectMap[t][r] = (uint8_t)s; break; }
+                }
+            }
+        }
+    }
+};
+
+static const NpnTables& Tables() {
+    static const NpnTables tables;
+    return tables;
+}
+
+CellMask ApplyNpnTransform(int t, CellMask mask) {
+    const NpnTables& tab = Tables();
+    return (CellMask)(tab.lo[t][mask & 0xFF] | tab.hi[t][mask >> 8]);
+}
+
+int InverseNpnTransform(int t) { return Tables().inverse[t]; }
+
+int TransformRect(int t, int rect) { return Tables().rectMap[t][rect]; }
+
+NpnCanonical CanonicalizeKMap(CellMask onMask, CellMask dcMask) {
+    const NpnTables& tab = Tables();
+    NpnCanonical best = { NPN_EMPTY_KEY, 0 };
+    for (int t = 0; t < NPN_TRANSFORM_COUNT; t++) {
+        uint32_t on = tab.lo[t][onMask & 0xFF] | tab.hi[t][onMask >> 8];
+        uint32_t dc = tab.lo[t][dcMask & 0xFF] | tab.hi[t][dcMask >> 8];
+        uint32_t key = on | (dc << 16);
+        if (key < best.key) { best.key = key; best.transform = t; }
+    }
+    return best;
+}
+
+// 檔案格式的一部分，修改時需要提高 NPN_DB_VERSION
+static uint32_t NpnSlot(uint32_t key, uint32_t capacity) {
+    return (uint32_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+// --- 產生 ---
+// 格子的 3 進位編號：on 的位元貢獻 3^b，dc 的位元貢獻 2 * 3^b
+struct TritIndex {
+    uint32_t lo[256], hi[256];
+    TritIndex() {
+        for (int v = 0; v < 256; v++) {
+            uint32_t l = 0, h = 0, p = 1, q = 6561; // 3^8
+            for (int b = 0; b < 8; b++, p *= 3, q *= 3) {
+                if ((v >> b) & 1) { l += p; h += q; }
+            }
+            lo[v] = l;
+            hi[v] = h;
+        }
+    }
+    uint32_t operator()(CellMask on, CellMask dc) const {
+        return lo[on & 0xFF] + hi[on >> 8] + 2 * (lo[dc & 0xFF] + hi[dc >> 8]);
+    }
+};
+
+void NpnDatabase::Build() {
+    Close();
+    const NpnTables& tab = Tables();
+    const TritIndex trit;
+    const uint32_t gridCount = 43046721; // 3^16
+    std::vector<uint64_t> visited((gridCount + 63) / 64, 0);
+
+    CoverOptions exact;
+    exact.method = CoverMethod::Exact;
+    exact.nodeLimit = 0; // 4 變數的質項表很小，不設預算以保證最少項數
+    exact.parallel = false;
+
+    std::vector<NpnDbRecord> classes;
+    for (uint32_t on = 0; on <= 0xFFFF; on++) {
+        const uint32_t rest = ~on & 0xFFFF;
+        uint32_t dc = 0;
+        do {
+            uint32_t index = trit((CellMask)on, (CellMask)dc);
+            if (!((visited[index / 64] >> (index % 64)) & 1)) {
+                // 標記整個等價類，同時找出正規形
+                uint32_t canonical = NPN_EMPTY_KEY;
+                for (int t = 0; t < NPN_TRANSFORM_COUNT; t++) {
+                    CellMask on2 = (CellMask)(tab.lo[t][on & 0xFF] | tab.hi[t][on >> 8]);
+                    CellMask dc2 = (CellMask)(tab.lo[t][dc & 0xFF] | tab.hi[t][dc >> 8]);
+                    uint32_t other = trit(on2, dc2);
+                    visited[other / 64] |= 1ull << (other % 64);
+                    uint32_t key = on2 | ((uint32_t)dc2 << 16);
+                    if (key < canonical) canonical = key;
+                }
+
+                NpnDbRecord rec;
+                memset(&rec, 0, sizeof(rec));
+                rec.key = canonical;
+                std::vector<KMapGroup> cover = SolveKMapMask((CellMask)(canonical & 0xFFFF), (CellMask)(canonical >> 16), exact);
+                rec.count = (uint8_t)cover.size();
+                for (size_t i = 0; i < cover.size() && i < (size_t)NPN_MAX_TERMS; i++) rec.rects[i] = (uint8_t)cover[i].rect;
+                classes.push_back(rec);
+            }
+            dc = (dc - rest) & rest;
+        } while (dc != 0);
+    }
+
+    // 負載不超過 3/4 的開放定址表
+    uint32_t capacity = 16;
+    while ((uint64_t)capacity * 3 < (uint64_t)classes.size() * 4) capacity <<= 1;
+    owned.assign(sizeof(NpnDbHeader) + (size_t)capacity * sizeof(NpnDbRecord), 0);
+    NpnDbHeader* head = (NpnDbHeader*)owned.data();
+    head->magic = NPN_DB_MAGIC;
+    head->version = NPN_DB_VERSION;
+    head->classCount = (uint32_t)classes.size();
+    head->capacity = capacity;
+    NpnDbRecord* table = (NpnDbRecord*)(owned.data() + sizeof(NpnDbHeader));
+    for (uint32_t i = 0; i < capacity; i++) table[i].key = NPN_EMPTY_KEY;
+    for (const NpnDbRecord& rec : classes) {
+        uint32_t slot = NpnSlot(rec.key, capacity);
+        while (table[slot].key != NPN_EMPTY_KEY) slot = (slot + 1) & (capacity - 1);
+        table[slot] = rec;
+    }
+    Attach(owned.data(), owned.size());
+}
+
+bool NpnDatabase::Save(const char* path) const {
+    if (!header) return false;
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    size_t size = sizeof(NpnDbHeader) + (size_t)header->capacity * sizeof(NpnDbRecord);
+    bool ok = fwrite(header, 1, size, f) == size;
+    return fclose(f) == 0 && ok;
+}
+
+// --- 載入 ---
+bool NpnDatabase::Attach(const uint8_t* data, size_t size) {
+    header = nullptr;
+    records = nullptr;
+    if (size < sizeof(NpnDbHeader)) return false;
+    const NpnDbHeader* head = (const NpnDbHeader*)data;
+    if (head->magic != NPN_DB_MAGIC || head->version != NPN_DB_VERSION) return false;
+    if (head->capacity == 0 || (head->capacity & (head->capacity - 1)) != 0 || head->classCount >= head->capacity) return false;
+    if (size != sizeof(NpnDbHeader) + (size_t)head->capacity * sizeof(NpnDbRecord)) return false;
+    header = head;
+    records = (const NpnDbRecord*)(data + sizeof(NpnDbHeader));
+    return true;
+}
+
+bool NpnDatabase::Open(const char* path) {
+    Close();
+    if (!file.Open(path)) return false;
+    if (!Attach(file.Data(), file.Size())) { file.Close(); return false; }
+    return true;
+}
+
+void NpnDatabase::Close() {
+    header = nullptr;
+    records = nullptr;
+    owned.clear();
+    file.Close();
+}
+
+bool NpnDatabase::Lookup(CellMask onMask, CellMask dcMask, std::vector<KMapGroup>& groups) const {
+    if (!header) return false;
+    NpnCanonical canon = CanonicalizeKMap(onMask, dcMask & (CellMask)~onMask);
+    const uint32_t capacity = header->capacity;
+    for (uint32_t slot = NpnSlot(canon.key, capacity);; slot = (slot + 1) & (capacity - 1)) {
+        const NpnDbRecord& rec = records[slot];
+        if (rec.key == NPN_EMPTY_KEY) return false;
+        if (rec.key != canon.key) continue;
+        if (rec.count > NPN_MAX_TERMS) return false;
+
+        // 正規形 = T(原本的格子)，因此覆蓋要套用 T 的反轉換
+        const int back = InverseNpnTransform(canon.transform);
+        groups.clear();
+        for (int i = 0; i < rec.count; i++) {
+            if (rec.rects[i] >= IMPLICANT_COUNT) return false;
+            groups.push_back(MakeGroup(TransformRect(back, rec.rects[i])));
+            groups.back().color = GROUP_COLORS[i % 6];
+        }
+        return true;
+    }
+}
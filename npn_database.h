@@ -0,0 +1,83 @@
+// 4 變數卡諾圖的預先計算解答庫：(on, dc) 經輸入排列 / 反相正規化後查表，可直接 mmap
+#ifndef NPN_DATABASE_H
+#define NPN_DATABASE_H
+
+#include "kmap_solver.h"
+#include "mapped_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 輸入的排列 (4!) 與反相 (2^4)。輸出反相會把 on 與 off 對調，最少 SOP 覆蓋無法由 ¬f 的解換回，
+// 因此只使用 NP 等價 (Don't Care 隨格子一起移動)
+const int NPN_TRANSFORM_COUNT = 384;
+const int NPN_MAX_TERMS = 8; // 4 變數的最少覆蓋最多 8 項 (奇偶函數)
+
+// 把格子遮罩 (bit = minterm) 套用第 t 個轉換
+CellMask ApplyNpnTransform(int t, CellMask mask);
+int InverseNpnTransform(int t);
+// 把 IMPLICANT_TABLE 中的框套用第 t 個轉換，回傳新的索引
+int TransformRect(int t, int rect);
+
+// 正規形：所有轉換中 (on | dc << 16) 最小者；transform 為把原本的格子變成正規形的轉換
+struct NpnCanonical {
+    uint32_t key;
+    int transform;
+};
+NpnCanonical CanonicalizeKMap(CellMask onMask, CellMask dcMask);
+
+// --- 檔案格式 (小端序) ---
+// 標頭之後是 capacity 筆記錄的開放定址 hash 表 (線性探測)，key 為正規形，空位為 NPN_EMPTY_KEY
+const uint32_t NPN_DB_MAGIC = 0x504E4D4B; // "KMNP"
+const uint32_t NPN_DB_VERSION = 1;
+const uint32_t NPN_EMPTY_KEY = 0xFFFFFFFFu; // on 與 dc 重疊，不可能是合法的格子
+
+struct NpnDbHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t classCount;
+    uint32_t capacity; // 2 的次方
+};
+
+struct NpnDbRecord {
+    uint32_t key;
+    uint8_t count;                 // 覆蓋項數
+    uint8_t rects[NPN_MAX_TERMS];  // 正規形下的 IMPLICANT_TABLE 索引
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(NpnDbHeader) == 16, "NPN database header must stay 16 bytes");
+static_assert(sizeof(NpnDbRecord) == 16, "NPN database records must stay 16 bytes");
+
+class NpnDatabase {
+public:
+    NpnDatabase() = default;
+    ~NpnDatabase() { Close(); }
+
+    NpnDatabase(const NpnDatabase&) = delete;
+    NpnDatabase& operator=(const NpnDatabase&) = delete;
+
+    // 以 mmap (Windows 為 MapViewOfFile) 開啟；格式不符時回傳 false
+    bool Open(const char* path);
+    void Close();
+
+    // 列舉全部 3^16 種格子的等價類，逐類以精確覆蓋求解 (產生器使用)
+    void Build();
+    bool Save(const char* path) const;
+
+    bool Loaded() const { return header != nullptr; }
+    uint32_t ClassCount() const { return header ? header->classCount : 0; }
+
+    // O(1)：正規化 + hash 查表 + 把覆蓋轉回原本的格子
+    bool Lookup(CellMask onMask, CellMask dcMask, std::vector<KMapGroup>& groups) const;
+
+private:
+    const NpnDbHeader* header = nullptr;
+    const NpnDbRecord* records = nullptr;
+    std::vector<uint8_t> owned; // Build 產生的資料
+    MappedFile file;
+
+    bool Attach(const uint8_t* data, size_t size);
+};
+
+#endif // NPN_DATABASE_H
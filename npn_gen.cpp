@@ -0,0 +1,71 @@
+// 產生並驗證 kmap_npn.bin
+// 用法：NpnGen [輸出路徑] [--full]
+//   預設驗證每一種格子的查表結果都是合法覆蓋且項數正確，並抽樣與即時化簡比對項數
+//   --full 時全部 3^16 種格子都與即時化簡比對 (較慢)
+#include "npn_database.h"
+#include "verifier.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+static int CheckGrid(const NpnDatabase& db, CellMask on, CellMask dc, bool compareLive, const CoverOptions& exact) {
+    std::vector<KMapGroup> groups;
+    if (!db.Lookup(on, dc, groups)) return 1;
+    VerifyReport report;
+    if (!VerifyKMapGroups(groups.data(), groups.size(), on, dc, &report)) {
+        if (report.badGroups) return 5; // 框的格子與文字不符
+        return report.extra ? 2 : 3;    // 碰到非目標格 / 沒覆蓋目標格
+    }
+    if (compareLive && groups.size() != SolveKMapMask(on, dc, exact).size()) return 4;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* path = "kmap_npn.bin";
+    bool full = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--full") == 0) full = true;
+        else path = argv[i];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    NpnDatabase built;
+    built.Build();
+    if (!built.Save(path)) { fprintf(stderr, "cannot write %s\n", path); return 1; }
+    double buildSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%u classes written to %s (%.1fs)\n", built.ClassCount(), path, buildSec);
+
+    // 從檔案重新開啟 (走 mmap 路徑) 再驗證
+    NpnDatabase db;
+    if (!db.Open(path)) { fprintf(stderr, "cannot map %s\n", path); return 1; }
+
+    CoverOptions exact;
+    exact.method = CoverMethod::Exact;
+    exact.nodeLimit = 0;
+    exact.parallel = false;
+
+    uint64_t checked = 0, failures = 0;
+    for (uint32_t on = 0; on <= 0xFFFF; on++) {
+        const uint32_t rest = ~on & 0xFFFF;
+        uint32_t dc = 0;
+        do {
+            int err = CheckGrid(db, (CellMask)on, (CellMask)dc, full, exact);
+            if (err && failures++ < 10) fprintf(stderr, "mismatch on=%04X dc=%04X (code %d)\n", on, dc, err);
+            checked++;
+            dc = (dc - rest) & rest;
+        } while (dc != 0);
+    }
+    if (!full) {
+        std::mt19937 rng(12345);
+        for (int i = 0; i < 200000; i++) {
+            CellMask on = (CellMask)rng();
+            CellMask dc = (CellMask)(rng() & rng() & ~on);
+            int err = CheckGrid(db, on, dc, true, exact);
+            if (err && failures++ < 10) fprintf(stderr, "mismatch on=%04X dc=%04X (code %d)\n", on, dc, err);
+        }
+    }
+    printf("verified %llu grids%s: %llu failures\n", (unsigned long long)checked,
+           full ? " against the live solver" : " (200000 sampled against the live solver)", (unsigned long long)failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+#include "qm.h"
+#include "bit_utils.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// --- 開放定址 hash：乘積項 key -> 索引 ---
+class ImplicantIndex {
+public:
+    // 清空並預留 expected 個元素的空間
+    void Reserve(size_t expected) {
+        size_t cap = 16;
+        while (cap < expected * 2) cap <<= 1;
+        keys.assign(cap, EMPTY);
+        vals.assign(cap, -1);
+        capMask = cap - 1;
+        count = 0;
+    }
+    int Find(uint64_t key) const {
+        for (size_t i = Hash(key) & capMask;; i = (i + 1) & capMask) {
+            if (keys[i] == key) return vals[i];
+            if (keys[i] == EMPTY) return -1;
+        }
+    }
+    // 已存在時回傳 false；負載超過一半時自動擴充
+    bool Insert(uint64_t key, int val) {
+        if ((count + 1) * 2 > keys.size()) Grow();
+        for (size_t i = Hash(key) & capMask;; i = (i + 1) & capMask) {
+            if (keys[i] == key) return false;
+            if (keys[i] == EMPTY) { keys[i] = key; vals[i] = val; count++; return true; }
+        }
+    }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ull; // value 與 mask 不可能同時全為 1
+    std::vector<uint64_t> keys;
+    std::vector<int> vals;
+    size_t capMask = 0;
+    size_t count = 0;
+
+    void Grow() {
+        std::vector<uint64_t> oldKeys;
+        std::vector<int> oldVals;
+        oldKeys.swap(keys);
+        oldVals.swap(vals);
+        Reserve(oldKeys.size()); // 容量加倍
+        for (size_t i = 0; i < oldKeys.size(); i++) if (oldKeys[i] != EMPTY) Insert(oldKeys[i], oldVals[i]);
+    }
+
+    static size_t Hash(uint64_t k) {
+        k ^= k >> 33; k *= 0xff51afd7ed558ccdull;
+        k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ull;
+        k ^= k >> 33;
+        return (size_t)k;
+    }
+};
+
+// 依 value 中 1 的個數分桶
+typedef std::vector<std::vector<Implicant>> Buckets;
+
+static bool KeyLess(const Implicant& a, const Implicant& b) { return a.Key() < b.Key(); }
+
+// 每個工作處理一個桶內連續的一段，合併結果先存在各自的 chunk 內
+const size_t QM_CHUNK_SIZE = 1024;
+const size_t QM_PARALLEL_MIN_TERMS = 4096; // 少於此數量時執行緒的開銷大於收益
+
+struct MergeChunk {
+    int bucket;
+    size_t begin, end;
+    std::vector<Implicant> merged; // 往上一桶合併得到的新項 (已排序、去重)
+};
+
+typedef std::unique_ptr<std::atomic<uint8_t>[]> UsedFlags;
+
+// 第 k 桶的每一項只需嘗試把某個 0 位元變成 1 去第 k+1 桶查表
+// 夥伴的 used 旗標可能被不同的工作同時設為 1，因此用 relaxed atomic 寫入 (值只會從 0 變 1，順序無關)
+static void MergeRange(const Buckets& cur, const std::vector<ImplicantIndex>& index, uint32_t varMask,
+                       MergeChunk& chunk, std::vector<UsedFlags>& used) {
+    const int k = chunk.bucket;
+    if (k + 1 >= (int)cur.size() || cur[k + 1].empty()) return;
+    for (size_t i = chunk.begin; i < chunk.end; i++) {
+        const Implicant& a = cur[k][i];
+        uint32_t free = varMask & ~a.mask & ~a.value;
+        while (free) {
+            uint32_t bit = free & (0u - free);
+            free &= free - 1;
+            int j = index[k + 1].Find(Implicant{a.value | bit, a.mask}.Key());
+            if (j < 0) continue;
+            used[k][i].store(1, std::memory_order_relaxed);
+            used[k + 1][j].store(1, std::memory_order_relaxed);
+            chunk.merged.push_back({a.value, a.mask | bit});
+        }
+    }
+    std::sort(chunk.merged.begin(), chunk.merged.end(), KeyLess);
+    chunk.merged.erase(std::unique(chunk.merged.begin(), chunk.merged.end()), chunk.merged.end());
+}
+
+// pool 為 nullptr 時依序執行
+static void RunTasks(ThreadPool* pool, size_t count, const std::function<void(size_t)>& body) {
+    if (pool) pool->ParallelFor(count, body);
+    else for (size_t i = 0; i < count; i++) body(i);
+}
+
+std::vector<Implicant> GeneratePrimes(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet,
+                                      bool parallel) {
+    std::vector<Implicant> primes;
+    if (numVars < QM_MIN_VARS || numVars > QM_MAX_VARS) return primes;
+    const uint32_t varMask = (uint32_t)((1ull << numVars) - 1);
+
+    std::vector<uint32_t> terms;
+    for (uint32_t m : onSet) if ((m & ~varMask) == 0) terms.push_back(m);
+    for (uint32_t m : dcSet) if ((m & ~varMask) == 0) terms.push_back(m);
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+
+    Buckets cur(numVars + 1);
+    for (uint32_t m : terms) cur[PopCount32(m)].push_back({m, 0});
+
+    while (true) {
+        size_t total = 0;
+        for (auto& b : cur) total += b.size();
+        if (total == 0) break;
+        ThreadPool* pool = (parallel && total >= QM_PARALLEL_MIN_TERMS) ? &ThreadPool::Shared() : nullptr;
+
+        // 第 0 桶不會被當成 hi 查表，不需要建索引
+        std::vector<ImplicantIndex> index(numVars + 1);
+        RunTasks(pool, cur.size(), [&](size_t k) {
+            if (k == 0) return;
+            index[k].Reserve(cur[k].size());
+            for (size_t i = 0; i < cur[k].size(); i++) index[k].Insert(cur[k][i].Key(), (int)i);
+        });
+
+        std::vector<UsedFlags> used(numVars + 1);
+        std::vector<MergeChunk> chunks;
+        for (int k = 0; k <= numVars; k++) {
+            used[k].reset(new std::atomic<uint8_t>[cur[k].size()]);
+            for (size_t i = 0; i < cur[k].size(); i++) used[k][i].store(0, std::memory_order_relaxed);
+            for (size_t b = 0; b < cur[k].size(); b += QM_CHUNK_SIZE)
+                chunks.push_back({k, b, std::min(b + QM_CHUNK_SIZE, cur[k].size()), {}});
+        }
+        RunTasks(pool, chunks.size(), [&](size_t c) { MergeRange(cur, index, varMask, chunks[c], used); });
+
+        // 同一階段的合併結果 value 與原項相同，因此第 k 桶的結果都落在下一階段的第 k 桶
+        // 各段的結果合併後排序去重，輸出與執行緒數無關
+        Buckets next(numVars + 1);
+        for (const MergeChunk& chunk : chunks)
+            next[chunk.bucket].insert(next[chunk.bucket].end(), chunk.merged.begin(), chunk.merged.end());
+        RunTasks(pool, next.size(), [&](size_t k) {
+            std::sort(next[k].begin(), next[k].end(), KeyLess);
+            next[k].erase(std::unique(next[k].begin(), next[k].end()), next[k].end());
+        });
+
+        for (int k = 0; k <= numVars; k++) {
+            for (size_t i = 0; i < cur[k].size(); i++) {
+                if (!used[k][i].load(std::memory_order_relaxed)) primes.push_back(cur[k][i]);
+            }
+        }
+        cur.swap(next);
+    }
+    return primes;
+}
+
+QMResult SolveQM(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet, const CoverOptions& opts) {
+    QMResult result;
+    result.stats.optimal = true;
+    if (numVars < QM_MIN_VARS || numVars > QM_MAX_VARS) return result;
+    const uint32_t varMask = (uint32_t)((1ull << numVars) - 1);
+
+    std::vector<uint32_t> rows;
+    for (uint32_t m : onSet) if ((m & ~varMask) == 0) rows.push_back(m);
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if (rows.empty()) return result;
+
+    std::vector<int> rowOf((size_t)1 << numVars, -1);
+    for (size_t i = 0; i < rows.size(); i++) rowOf[rows[i]] = (int)i;
+
+    // 只留下至少覆蓋一個目標 minterm 的質項
+    for (const Implicant& p : GeneratePrimes(numVars, rows, dcSet, opts.parallel)) {
+        uint32_t sub = 0;
+        do {
+            if (rowOf[p.value | sub] >= 0) { result.primes.push_back(p); break; }
+            sub = (sub - p.mask) & p.mask;
+        } while (sub != 0);
+    }
+
+    CoverProblem chart;
+    chart.Init((int)rows.size(), (int)result.primes.size());
+    for (size_t c = 0; c < result.primes.size(); c++) {
+        const Implicant& p = result.primes[c];
+        uint32_t sub = 0;
+        do {
+            int r = rowOf[p.value | sub];
+            if (r >= 0) chart.Set((int)c, r);
+            sub = (sub - p.mask) & p.mask;
+        } while (sub != 0);
+    }
+
+    result.stats = SolveCover(chart, opts);
+    for (int c : result.stats.cols) result.cover.push_back(result.primes[c]);
+    return result;
+}
+
+// --- 字串生成 ---
+std::string GetImplicantTerm(const Implicant& imp, int numVars, bool isPOS) {
+    const uint32_t varMask = (uint32_t)((1ull << numVars) - 1);
+    if ((imp.mask & varMask) == varMask) return isPOS ? "0" : "1";
+    std::string term = isPOS ? "(" : "";
+    bool first = true;
+    for (int v = 0; v < numVars; v++) {
+        int bit = numVars - 1 - v;
+        if ((imp.mask >> bit) & 1) continue;
+        if (isPOS && !first) term += "+";
+        term += (char)('A' + v);
+        bool positive = ((imp.value >> bit) & 1) != 0;
+        if (positive == isPOS) term += "'";
+        first = false;
+    }
+    if (isPOS) term += ")";
+    return term;
+}
+
+std::string GenerateQMFormula(const std::vector<Implicant>& terms, int numVars, bool isPOS) {
+    if (terms.empty()) return isPOS ? "F = 1" : "F = 0";
+    std::string formula = "F = ";
+    for (size_t i = 0; i < terms.size(); i++) {
+        formula += GetImplicantTerm(terms[i], numVars, isPOS);
+        if (i < terms.size() - 1) formula += (isPOS ? "" : " + ");
+    }
+    return formula;
+}
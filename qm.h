@@ -0,0 +1,43 @@
+// Quine-McCluskey 化簡 (任意變數數)
+#ifndef QM_H
+#define QM_H
+
+#include "cover.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const int QM_MIN_VARS = 1;
+const int QM_MAX_VARS = 20;
+
+// 乘積項：mask 位元為被合併掉的變數，value 為其餘變數的值 (value & mask == 0)
+// 變數 A 對應最高位元 (bit numVars-1)，與 4 變數卡諾圖的 minterm 編號一致
+struct Implicant {
+    uint32_t value;
+    uint32_t mask;
+    bool operator==(const Implicant& other) const { return value == other.value && mask == other.mask; }
+    uint64_t Key() const { return ((uint64_t)mask << 32) | value; }
+    bool Covers(uint32_t minterm) const { return (minterm & ~mask) == value; }
+};
+
+struct QMResult {
+    std::vector<Implicant> primes; // 至少覆蓋一個目標 minterm 的質項
+    std::vector<Implicant> cover;  // 選中的質項
+    CoverResult stats;
+};
+
+// 以 Quine-McCluskey 列表法求出所有質項 (依 1 的個數分桶，hash 去除重複)
+// 超出 numVars 範圍的 minterm 會被忽略
+// parallel 時大型問題的合併階段會分段交給共用執行緒池，輸出與單執行緒完全相同
+std::vector<Implicant> GeneratePrimes(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet,
+                                      bool parallel = true);
+
+// 完整化簡：質項 + 覆蓋。POS 時傳入 0 的 minterm 當作 onSet
+QMResult SolveQM(int numVars, const std::vector<uint32_t>& onSet, const std::vector<uint32_t>& dcSet,
+                 const CoverOptions& opts = CoverOptions());
+
+// --- 字串生成 ---
+std::string GetImplicantTerm(const Implicant& imp, int numVars, bool isPOS);
+std::string GenerateQMFormula(const std::vector<Implicant>& terms, int numVars, bool isPOS);
+
+#endif // QM_H
@@ -0,0 +1,402 @@
+#include "sat_solver.h"
+#include <algorithm>
+
+const double SAT_VAR_DECAY = 0.95;
+const double SAT_CLAUSE_DECAY = 0.999;
+const uint64_t SAT_RESTART_UNIT = 100;  // Luby 數列的單位 (衝突數)
+const uint64_t SAT_STOP_INTERVAL = 256; // 每隔多少次衝突檢查 stop
+
+// Luby 數列 1 1 2 1 1 2 4 1 1 2 ... 的第 i 項 (i 從 0 起)
+static uint64_t Luby(uint64_t i) {
+    uint64_t size = 1, seq = 0;
+    while (size < i + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+        size = (size - 1) >> 1;
+        seq--;
+        i = i % size;
+    }
+    return (uint64_t)1 << seq;
+}
+
+void SatSolver::Reset() {
+    clauses.clear();
+    litPool.clear();
+    learnts.clear();
+    // 監看串列只清空不釋放，之後的 NewVar 直接沿用
+    for (auto& ws : watches) ws.clear();
+    assigns.clear();
+    level.clear();
+    reason.clear();
+    phase.clear();
+    model.clear();
+    trail.clear();
+    trailLim.clear();
+    qhead = 0;
+    activity.clear();
+    heap.clear();
+    heapIndex.clear();
+    varInc = 1.0;
+    clauseInc = 1.0;
+    seen.clear();
+    ok = true;
+    conflicts = 0;
+    decisions = 0;
+    maxLearnts = 0;
+    wasted = 0;
+}
+
+int SatSolver::NewVar() {
+    const int v = (int)assigns.size();
+    assigns.push_back(0);
+    level.push_back(0);
+    reason.push_back(-1);
+    phase.push_back(0);
+    model.push_back(0);
+    activity.push_back(0.0);
+    seen.push_back(0);
+    heapIndex.push_back(-1);
+    if (watches.size() < assigns.size() * 2) watches.resize(assigns.size() * 2);
+    HeapInsert(v);
+    return v;
+}
+
+// --- 子句 ---
+bool SatSolver::AddClause(const SatLit* lits, size_t count) {
+    if (!ok) return false;
+    // 只在第 0 層加入：去掉重複與為假的字母，已滿足的子句直接略過
+    std::vector<SatLit>& clause = scratch;
+    clause.assign(lits, lits + count);
+    std::sort(clause.begin(), clause.end());
+    size_t kept = 0;
+    for (size_t i = 0; i < clause.size(); i++) {
+        const SatLit l = clause[i];
+        if (LitValue(l) > 0 || (kept > 0 && clause[kept - 1] == NegLit(l))) return true;
+        if (LitValue(l) < 0 || (kept > 0 && clause[kept - 1] == l)) continue;
+        clause[kept++] = l;
+    }
+    if (kept == 0) return ok = false;
+    if (kept == 1) {
+        Enqueue(clause[0], -1);
+        return ok = (Propagate() < 0);
+    }
+    AttachClause(clause.data(), kept, false);
+    return true;
+}
+
+int SatSolver::AttachClause(const SatLit* lits, size_t count, bool learnt) {
+    const int c = (int)clauses.size();
+    clauses.push_back({ (uint32_t)litPool.size(), (uint32_t)count, learnt, false, 0.0 });
+    litPool.insert(litPool.end(), lits, lits + count);
+    watches[lits[0]].push_back({ c, lits[1] });
+    watches[lits[1]].push_back({ c, lits[0] });
+    if (learnt) learnts.push_back(c);
+    return c;
+}
+
+// --- 推論 ---
+void SatSolver::Enqueue(SatLit l, int from) {
+    const int v = LitVar(l);
+    assigns[v] = (l & 1) ? -1 : 1;
+    level[v] = DecisionLevel();
+    reason[v] = from;
+    trail.push_back(l);
+}
+
+// 單位傳遞；回傳衝突的子句，沒有衝突時回傳 -1
+// 監看字母放在子句的前兩格：字母 p 變為真時只需檢查監看 ¬p 的子句
+int SatSolver::Propagate() {
+    while (qhead < trail.size()) {
+        const SatLit falseLit = NegLit(trail[qhead++]);
+        std::vector<Watcher>& ws = watches[falseLit];
+        size_t i = 0, j = 0;
+        while (i < ws.size()) {
+            const Watcher w = ws[i++];
+            if (clauses[w.clause].deleted) continue;
+            if (LitValue(w.blocker) > 0) {
+                ws[j++] = w;
+                continue;
+            }
+            SatLit* lits = Lits(w.clause);
+            if (lits[0] == falseLit) std::swap(lits[0], lits[1]);
+            const SatLit first = lits[0];
+            if (first != w.blocker && LitValue(first) > 0) {
+                ws[j++] = { w.clause, first };
+                continue;
+            }
+            // 找另一個不為假的字母來監看
+            const uint32_t size = clauses[w.clause].size;
+            bool moved = false;
+            for (uint32_t k = 2; k < size; k++) {
+                if (LitValue(lits[k]) >= 0) {
+                    std::swap(lits[1], lits[k]);
+                    watches[lits[1]].push_back({ w.clause, first });
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+            ws[j++] = { w.clause, first };
+            if (LitValue(first) < 0) {
+                while (i < ws.size()) ws[j++] = ws[i++];
+                ws.resize(j);
+                qhead = trail.size();
+                return w.clause;
+            }
+            Enqueue(first, w.clause);
+        }
+        ws.resize(j);
+    }
+    return -1;
+}
+
+// --- 衝突分析 ---
+// 1-UIP：從衝突子句往回消去目前層的字母，直到只剩一個；backLevel 為學習子句中次高的層級
+void SatSolver::Analyze(int confl, std::vector<SatLit>& learnt, int& backLevel) {
+    learnt.assign(1, 0);
+    int pending = 0;
+    SatLit p = -1;
+    size_t index = trail.size();
+    do {
+        BumpClause(confl);
+        const SatLit* lits = Lits(confl);
+        for (uint32_t k = (p < 0 ? 0 : 1); k < clauses[confl].size; k++) {
+            const int v = LitVar(lits[k]);
+            if (seen[v] || level[v] == 0) continue;
+            seen[v] = 1;
+            BumpVar(v);
+            if (level[v] >= DecisionLevel()) pending++;
+            else learnt.push_back(lits[k]);
+        }
+        while (!seen[LitVar(trail[--index])]) {}
+        p = trail[index];
+        confl = reason[LitVar(p)];
+        seen[LitVar(p)] = 0;
+        pending--;
+    } while (pending > 0);
+    learnt[0] = NegLit(p);
+
+    // 去掉可由學習子句中其他字母推出的字母 (只看一層原因)
+    // 判斷完才清除 seen (Redundant 要看到所有原本的字母)
+    size_t kept = 1;
+    for (size_t i = 1; i < learnt.size(); i++) {
+        if (!Redundant(learnt[i])) std::swap(learnt[kept++], learnt[i]);
+    }
+    for (size_t i = 1; i < learnt.size(); i++) seen[LitVar(learnt[i])] = 0;
+    learnt.resize(kept);
+
+    backLevel = 0;
+    if (learnt.size() > 1) {
+        size_t best = 1;
+        for (size_t i = 2; i < learnt.size(); i++) {
+            if (level[LitVar(learnt[i])] > level[LitVar(learnt[best])]) best = i;
+        }
+        std::swap(learnt[1], learnt[best]);
+        backLevel = level[LitVar(learnt[1])];
+    }
+}
+
+bool SatSolver::Redundant(SatLit l) {
+    const int from = reason[LitVar(l)];
+    if (from < 0) return false;
+    const SatLit* lits = Lits(from);
+    for (uint32_t k = 1; k < clauses[from].size; k++) {
+        const int v = LitVar(lits[k]);
+        if (!seen[v] && level[v] > 0) return false;
+    }
+    return true;
+}
+
+void SatSolver::Backtrack(int target) {
+    if (DecisionLevel() <= target) return;
+    for (size_t i = trail.size(); i-- > (size_t)trailLim[target];) {
+        const int v = LitVar(trail[i]);
+        phase[v] = assigns[v] > 0;
+        assigns[v] = 0;
+        reason[v] = -1;
+        if (heapIndex[v] < 0) HeapInsert(v);
+    }
+    trail.resize(trailLim[target]);
+    trailLim.resize(target);
+    qhead = trail.size();
+}
+
+int SatSolver::PickBranch() {
+    while (!heap.empty()) {
+        const int v = HeapPop();
+        if (assigns[v] == 0) return v;
+    }
+    return -1;
+}
+
+// --- 學習子句清理 ---
+// 保留活性較高的一半；二元子句與目前作為原因的子句不刪
+void SatSolver::ReduceLearnts() {
+    std::sort(learnts.begin(), learnts.end(),
+              [&](int a, int b) { return clauses[a].activity < clauses[b].activity; });
+    const size_t half = learnts.size() / 2;
+    size_t kept = 0;
+    for (size_t i = 0; i < learnts.size(); i++) {
+        Clause& c = clauses[learnts[i]];
+        const SatLit first = litPool[c.start];
+        const bool locked = reason[LitVar(first)] == learnts[i] && LitValue(first) > 0;
+        if (i < half && c.size > 2 && !locked) {
+            c.deleted = true;
+            wasted += c.size;
+        } else {
+            learnts[kept++] = learnts[i];
+        }
+    }
+    learnts.resize(kept);
+    if (wasted > litPool.size() / 2) CompactClauses();
+}
+
+// 重新排列子句表並重建監看 (只在第 0 層呼叫，第 0 層的原因不再使用)
+void SatSolver::CompactClauses() {
+    std::vector<Clause>& oldClauses = spareClauses;
+    std::vector<SatLit>& oldPool = sparePool;
+    oldClauses.swap(clauses);
+    oldPool.swap(litPool);
+    clauses.clear();
+    litPool.clear();
+    for (auto& ws : watches) ws.clear();
+    learnts.clear();
+    for (size_t c = 0; c < oldClauses.size(); c++) {
+        if (oldClauses[c].deleted) continue;
+        AttachClause(&oldPool[oldClauses[c].start], oldClauses[c].size, oldClauses[c].learnt);
+        clauses.back().activity = oldClauses[c].activity;
+    }
+    for (SatLit l : trail) reason[LitVar(l)] = -1;
+    oldClauses.clear();
+    oldPool.clear();
+    wasted = 0;
+}
+
+// --- VSIDS ---
+void SatSolver::BumpVar(int v) {
+    if ((activity[v] += varInc) > 1e100) {
+        for (double& a : activity) a *= 1e-100;
+        varInc *= 1e-100;
+    }
+    if (heapIndex[v] >= 0) HeapUp(heapIndex[v]);
+}
+
+void SatSolver::BumpClause(int c) {
+    if (!clauses[c].learnt) return;
+    if ((clauses[c].activity += clauseInc) > 1e20) {
+        for (int l : learnts) clauses[l].activity *= 1e-20;
+        clauseInc *= 1e-20;
+    }
+}
+
+void SatSolver::HeapUp(int i) {
+    const int v = heap[i];
+    while (i > 0) {
+        const int parent = (i - 1) >> 1;
+        if (activity[heap[parent]] >= activity[v]) break;
+        heap[i] = heap[parent];
+        heapIndex[heap[i]] = i;
+        i = parent;
+    }
+    heap[i] = v;
+    heapIndex[v] = i;
+}
+
+void SatSolver::HeapDown(int i) {
+    const int v = heap[i];
+    const int size = (int)heap.size();
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= size) break;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) child++;
+        if (activity[heap[child]] <= activity[v]) break;
+        heap[i] = heap[child];
+        heapIndex[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = v;
+    heapIndex[v] = i;
+}
+
+void SatSolver::HeapInsert(int v) {
+    heap.push_back(v);
+    HeapUp((int)heap.size() - 1);
+}
+
+int SatSolver::HeapPop() {
+    const int top = heap[0];
+    heapIndex[top] = -1;
+    const int last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        HeapDown(0);
+    }
+    return top;
+}
+
+// --- 求解 ---
+SatStatus SatSolver::Solve(uint64_t conflictLimit, const std::function<bool()>& stop) {
+    if (!ok) return SatStatus::Unsat;
+    if (Propagate() >= 0) {
+        ok = false;
+        return SatStatus::Unsat;
+    }
+    if (maxLearnts == 0) maxLearnts = clauses.size() / 3 + 1000;
+
+    std::vector<SatLit>& learnt = scratch;
+    uint64_t callConflicts = 0, restarts = 0;
+    uint64_t restartAt = Luby(0) * SAT_RESTART_UNIT;
+    for (;;) {
+        const int confl = Propagate();
+        if (confl >= 0) {
+            conflicts++;
+            callConflicts++;
+            if (DecisionLevel() == 0) {
+                ok = false;
+                return SatStatus::Unsat;
+            }
+            int backLevel;
+            Analyze(confl, learnt, backLevel);
+            Backtrack(backLevel);
+            if (learnt.size() == 1) {
+                Enqueue(learnt[0], -1);
+            } else {
+                const int c = AttachClause(learnt.data(), learnt.size(), true);
+                BumpClause(c);
+                Enqueue(learnt[0], c);
+            }
+            varInc /= SAT_VAR_DECAY;
+            clauseInc /= SAT_CLAUSE_DECAY;
+
+            if ((conflictLimit && callConflicts >= conflictLimit) ||
+                (stop && callConflicts % SAT_STOP_INTERVAL == 0 && stop())) {
+                Backtrack(0);
+                return SatStatus::Unknown;
+            }
+            continue;
+        }
+
+        if (callConflicts >= restartAt) {
+            Backtrack(0);
+            restartAt = callConflicts + Luby(++restarts) * SAT_RESTART_UNIT;
+        }
+        if (DecisionLevel() == 0 && learnts.size() >= maxLearnts) {
+            ReduceLearnts();
+            maxLearnts += maxLearnts / 10;
+        }
+
+        const int v = PickBranch();
+        if (v < 0) {
+            for (int u = 0; u < NumVars(); u++) model[u] = assigns[u] > 0;
+            // 回到第 0 層，之後可以繼續加子句
+            Backtrack(0);
+            return SatStatus::Sat;
+        }
+        decisions++;
+        trailLim.push_back((int)trail.size());
+        Enqueue(MakeLit(v, !phase[v]), -1);
+    }
+}
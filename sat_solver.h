@@ -0,0 +1,110 @@
+// 輕量 CDCL SAT 求解器 (不依賴外部求解器)：兩個監看字母 (two watched literals)、1-UIP 學習子句、
+// VSIDS 變數活性、相位記憶、Luby 重啟與學習子句清理
+// 增量使用：Solve 回傳後仍在第 0 層，可以繼續加子句 (例如收緊成本上限) 再解，學到的子句保留下來
+// Reset 後重複使用同一個物件時保留所有陣列的容量，問題大小不變時不再向 heap 要記憶體
+#ifndef SAT_SOLVER_H
+#define SAT_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+// 變數 v (從 0 起) 的正字母為 2v，負字母為 2v + 1
+typedef int SatLit;
+
+inline SatLit MakeLit(int var, bool negative = false) { return 2 * var + (negative ? 1 : 0); }
+inline SatLit NegLit(SatLit l) { return l ^ 1; }
+inline int LitVar(SatLit l) { return l >> 1; }
+
+enum class SatStatus { Sat, Unsat, Unknown };
+
+class SatSolver {
+public:
+    // 清空所有變數與子句 (保留容量)
+    void Reset();
+    int NewVar();
+    int NumVars() const { return (int)assigns.size(); }
+
+    // 頂層已矛盾時回傳 false (之後 Solve 一律 Unsat)
+    bool AddClause(const SatLit* lits, size_t count);
+    bool AddClause(std::initializer_list<SatLit> lits) { return AddClause(lits.begin(), lits.size()); }
+
+    // conflictLimit：這次呼叫最多的衝突數，0 = 不限；用完或 stop 回傳 true 時為 Unknown
+    // stop 每 256 次衝突呼叫一次 (取消旗標、時間上限)
+    SatStatus Solve(uint64_t conflictLimit = 0, const std::function<bool()>& stop = nullptr);
+
+    // 最近一次 Sat 的解
+    bool Value(int var) const { return model[var] != 0; }
+
+    uint64_t Conflicts() const { return conflicts; }
+    uint64_t Decisions() const { return decisions; }
+
+private:
+    struct Clause {
+        uint32_t start; // litPool 中的起點
+        uint32_t size;
+        bool learnt;
+        bool deleted;
+        double activity;
+    };
+    struct Watcher {
+        int clause;
+        SatLit blocker; // 子句中的另一個字母，為真時不必打開子句
+    };
+
+    std::vector<Clause> clauses;
+    std::vector<SatLit> litPool;
+    std::vector<int> learnts;
+    std::vector<std::vector<Watcher>> watches; // 依字母：監看此字母的子句 (字母變為假時檢查)
+
+    std::vector<int8_t> assigns; // 1 = 真，-1 = 假，0 = 未指定
+    std::vector<int> level;
+    std::vector<int> reason;     // 推出此值的子句，-1 = 決策或頂層
+    std::vector<uint8_t> phase;  // 上次的值 (相位記憶)，初始為假
+    std::vector<uint8_t> model;
+    std::vector<SatLit> trail;
+    std::vector<int> trailLim;
+    size_t qhead = 0;
+
+    // VSIDS：以活性排序的二元堆積
+    std::vector<double> activity;
+    std::vector<int> heap;
+    std::vector<int> heapIndex; // -1 = 不在堆積中
+    double varInc = 1.0;
+    double clauseInc = 1.0;
+
+    std::vector<uint8_t> seen;
+    std::vector<SatLit> scratch;       // AddClause 的整理 / Solve 的學習子句
+    std::vector<Clause> spareClauses;  // CompactClauses 換出的舊子句表
+    std::vector<SatLit> sparePool;
+    bool ok = true;
+    uint64_t conflicts = 0;
+    uint64_t decisions = 0;
+    size_t maxLearnts = 0;
+    size_t wasted = 0; // 已刪除子句在 litPool 中佔的空間
+
+    int8_t LitValue(SatLit l) const { return (l & 1) ? (int8_t)-assigns[l >> 1] : assigns[l >> 1]; }
+    SatLit* Lits(int c) { return &litPool[clauses[c].start]; }
+    int DecisionLevel() const { return (int)trailLim.size(); }
+
+    int AttachClause(const SatLit* lits, size_t count, bool learnt);
+    void Enqueue(SatLit l, int from);
+    int Propagate();
+    void Analyze(int confl, std::vector<SatLit>& learnt, int& backLevel);
+    bool Redundant(SatLit l);
+    void Backtrack(int target);
+    int PickBranch();
+    void ReduceLearnts();
+    void CompactClauses();
+
+    void BumpVar(int v);
+    void BumpClause(int c);
+    void HeapUp(int i);
+    void HeapDown(int i);
+    void HeapInsert(int v);
+    int HeapPop();
+};
+
+#endif // SAT_SOLVER_H
@@ -0,0 +1,75 @@
+// 內建容量的小向量：元素數不超過 N 時完全不向 heap 要記憶體，超過時才改用 heap
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// 只用於 trivially copyable 的型別 (化簡器中的框、索引等)，搬移時直接 memcpy
+template <typename T, size_t N>
+class SmallVec {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVec only holds trivially copyable data");
+
+public:
+    SmallVec() = default;
+    SmallVec(const SmallVec& other) { Append(other.data(), other.count); }
+    SmallVec& operator=(const SmallVec& other) {
+        if (this != &other) { clear(); Append(other.data(), other.count); }
+        return *this;
+    }
+    ~SmallVec() { delete[] heap; }
+
+    T* data() { return heap ? heap : inlineData; }
+    const T* data() const { return heap ? heap : inlineData; }
+    size_t size() const { return count; }
+    size_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+    bool spilled() const { return heap != nullptr; }
+
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    T& back() { return data()[count - 1]; }
+    const T& back() const { return data()[count - 1]; }
+    T* begin() { return data(); }
+    T* end() { return data() + count; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + count; }
+
+    // 清空但保留容量 (包括已經換到 heap 的空間)
+    void clear() { count = 0; }
+
+    void push_back(const T& value) {
+        if (count == cap) Grow(cap * 2);
+        data()[count++] = value;
+    }
+
+    void pop_back() { count--; }
+
+    void resize(size_t n) {
+        if (n > cap) Grow(n);
+        count = n;
+    }
+
+    void Append(const T* src, size_t n) {
+        if (count + n > cap) Grow(count + n > cap * 2 ? count + n : cap * 2);
+        if (n) memcpy(data() + count, src, n * sizeof(T));
+        count += n;
+    }
+
+private:
+    T inlineData[N];
+    T* heap = nullptr;
+    size_t count = 0;
+    size_t cap = N;
+
+    void Grow(size_t newCap) {
+        T* bigger = new T[newCap];
+        if (count) memcpy(bigger, data(), count * sizeof(T));
+        delete[] heap;
+        heap = bigger;
+        cap = newCap;
+    }
+};
+
+#endif // SMALL_VECTOR_H
@@ -0,0 +1,70 @@
+#include "solution_cache.h"
+
+uint64_t SolutionCache::MakeKey(CellMask onMask, CellMask dcMask, int targetVal, const CoverOptions& opts) {
+    return (uint64_t)onMask | ((uint64_t)dcMask << 16) | ((uint64_t)(targetVal & 0xFF) << 32) |
+           ((uint64_t)opts.method << 40) | ((uint64_t)opts.costModel << 44);
+}
+
+bool SolutionCache::Lookup(uint64_t key, std::vector<KMapGroup>& groups, CoverResult* stats) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = index.find(key);
+    if (it == index.end()) { counters.misses++; return false; }
+    counters.hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    groups = it->second->groups;
+    if (stats) *stats = it->second->stats;
+    return true;
+}
+
+void SolutionCache::Store(uint64_t key, const std::vector<KMapGroup>& groups, const CoverResult& stats) {
+    if (capacity == 0) return;
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->groups = groups;
+        it->second->stats = stats;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    entries.push_front({key, groups, stats});
+    index[key] = entries.begin();
+    if (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+        counters.evictions++;
+    }
+}
+
+void SolutionCache::Clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    index.clear();
+}
+
+SolutionCacheStats SolutionCache::Stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    SolutionCacheStats s = counters;
+    s.size = entries.size();
+    return s;
+}
+
+SolutionCache& SolutionCache::Shared() {
+    static SolutionCache cache;
+    return cache;
+}
+
+std::vector<KMapGroup> SolveKMapCached(int data[4][4], int targetVal, const CoverOptions& opts, CoverResult* stats,
+                                       SolutionCache& cache) {
+    CellMask onMask, dcMask;
+    GridToMasks(data, targetVal, onMask, dcMask);
+    uint64_t key = SolutionCache::MakeKey(onMask, dcMask, targetVal, opts);
+    std::vector<KMapGroup> groups;
+    CoverResult res;
+    if (!cache.Lookup(key, groups, &res)) {
+        groups = SolveKMapMask(onMask, dcMask, opts, &res);
+        // 預算用完的結果不一定最好，不放進快取
+        if (opts.method == CoverMethod::Greedy || res.optimal) cache.Store(key, groups, res);
+    }
+    if (stats) *stats = res;
+    return groups;
+}
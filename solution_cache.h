@@ -0,0 +1,55 @@
+// 化簡結果的 LRU 快取：Undo、清除、SOP/POS 切換回到剛解過的格子時直接查表
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+#include "kmap_solver.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct SolutionCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t size = 0;
+};
+
+// 多執行緒共用 (GUI 的背景執行緒與批次呼叫)，內部以 mutex 保護
+class SolutionCache {
+public:
+    explicit SolutionCache(size_t capacity = 1024) : capacity(capacity) {}
+
+    // 4 變數的格子可以完整放進 64 位元：on / dc 遮罩 + targetVal + 覆蓋方法 + 成本模型，不會碰撞
+    static uint64_t MakeKey(CellMask onMask, CellMask dcMask, int targetVal, const CoverOptions& opts);
+
+    bool Lookup(uint64_t key, std::vector<KMapGroup>& groups, CoverResult* stats = nullptr);
+    void Store(uint64_t key, const std::vector<KMapGroup>& groups, const CoverResult& stats);
+    void Clear();
+
+    SolutionCacheStats Stats() const;
+
+    // 全程式共用的快取
+    static SolutionCache& Shared();
+
+private:
+    struct Entry {
+        uint64_t key;
+        std::vector<KMapGroup> groups;
+        CoverResult stats;
+    };
+
+    size_t capacity;
+    mutable std::mutex lock;
+    std::list<Entry> entries; // 前端為最近使用
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    SolutionCacheStats counters;
+};
+
+// 先查快取，沒有才呼叫 SolveKMap 並存入
+std::vector<KMapGroup> SolveKMapCached(int data[4][4], int targetVal, const CoverOptions& opts = CoverOptions(),
+                                       CoverResult* stats = nullptr, SolutionCache& cache = SolutionCache::Shared());
+
+#endif // SOLUTION_CACHE_H
@@ -0,0 +1,1053 @@
+// 化簡引擎回歸測試 (ctest)：每個模組與暴力解或另一個獨立實作比對，亂數種子固定，結果可重現
+// 任何一項失敗時印出 FAIL 並以非 0 結束
+#include "bdd.h"
+#include "bit_utils.h"
+#include "bitset_kernels.h"
+#include "consensus.h"
+#include "cover.h"
+#include "dancing_links.h"
+#include "espresso.h"
+#include "incremental_solver.h"
+#include "isop.h"
+#include "kmap_solver.h"
+#include "kmap_template.h"
+#include "multi_output.h"
+#include "npn_database.h"
+#include "qm.h"
+#include "sat_solver.h"
+#include "solution_cache.h"
+#include "solver_worker.h"
+#include "thread_pool.h"
+#include "truth_table.h"
+#include "verifier.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(bool ok, const char* what, int detail = -1) {
+    if (ok) return;
+    failures++;
+    if (failures <= 20) {
+        if (detail >= 0) printf("FAIL: %s (%d)\n", what, detail);
+        else printf("FAIL: %s\n", what);
+    }
+}
+
+// --- 配置計數 (SolverContext 穩定狀態不配置記憶體) ---
+static std::atomic<size_t> allocationCount{ 0 };
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+// std::stable_sort 等以 nothrow 版本配置，一併計數並與上面的 delete 配對
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    allocationCount++;
+    return malloc(size ? size : 1);
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+static std::vector<uint64_t> SortedKeys(const std::vector<Implicant>& terms) {
+    std::vector<uint64_t> keys;
+    for (const Implicant& t : terms) keys.push_back(t.Key());
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// 隨機的 on / dc 分配 (百分比)
+static void RandomFunction(std::mt19937& rng, int numVars, int onPercent, int dcPercent,
+                           std::vector<uint32_t>& onSet, std::vector<uint32_t>& dcSet) {
+    onSet.clear();
+    dcSet.clear();
+    for (uint32_t m = 0; m < (1u << numVars); m++) {
+        int r = (int)(rng() % 100);
+        if (r < onPercent) onSet.push_back(m);
+        else if (r < onPercent + dcPercent) dcSet.push_back(m);
+    }
+}
+
+// --- 真值表：0–10 變數與逐格的參考實作比對 ---
+static void TestTruthTable() {
+    std::mt19937 rng(1);
+    for (int it = 0; it < 2200; it++) {
+        const int n = it % 11;
+        const uint32_t size = 1u << n;
+        std::vector<uint8_t> f(size);
+        TruthTable t(n);
+        for (uint32_t m = 0; m < size; m++) {
+            f[m] = rng() & 1;
+            if (f[m]) t.Set(m);
+        }
+        auto same = [&](const TruthTable& x, const std::vector<uint8_t>& g) {
+            for (uint32_t m = 0; m < size; m++) if (x.Get(m) != (g[m] != 0)) return false;
+            return true;
+        };
+        int count = 0;
+        for (uint8_t v : f) count += v;
+        Check(same(t, f) && t.Count() == count, "truth table set / count", n);
+        std::vector<uint8_t> g(size);
+        for (uint32_t m = 0; m < size; m++) g[m] = !f[m];
+        Check(same(~t, g), "truth table complement", n);
+        if (n == 0) continue;
+
+        const int v = (int)(rng() % n), b = (int)(rng() % n);
+        for (int value = 0; value < 2; value++) {
+            for (uint32_t m = 0; m < size; m++) g[m] = f[value ? (m | 1u << v) : (m & ~(1u << v))];
+            Check(same(t.Cofactor(v, value != 0), g), "truth table cofactor", n);
+        }
+        bool depends = false;
+        for (uint32_t m = 0; m < size; m++) if (f[m] != f[m ^ (1u << v)]) depends = true;
+        Check(depends == t.DependsOn(v), "truth table support", n);
+
+        TruthTable swapped = t;
+        swapped.SwapVars(v, b);
+        for (uint32_t m = 0; m < size; m++) {
+            uint32_t x = m & ~((1u << v) | (1u << b));
+            x |= ((m >> v) & 1) << b | ((m >> b) & 1) << v;
+            g[m] = f[x];
+        }
+        Check(same(swapped, g), "truth table swap", n);
+
+        std::vector<int> perm(n);
+        for (int i = 0; i < n; i++) perm[i] = i;
+        std::shuffle(perm.begin(), perm.end(), rng);
+        const uint32_t negMask = rng() & (size - 1);
+        const bool negOutput = rng() & 1;
+        TruthTable npn = t;
+        npn.ApplyNpn(perm.data(), negMask, negOutput);
+        for (uint32_t x = 0; x < size; x++) {
+            uint32_t flipped = x ^ negMask, y = 0;
+            for (int i = 0; i < n; i++) if ((flipped >> i) & 1) y |= 1u << perm[i];
+            g[y] = f[x] ^ (negOutput ? 1 : 0);
+        }
+        Check(same(npn, g), "truth table NPN", n);
+    }
+}
+
+// --- 覆蓋引擎：貪婪法完整、精確法與暴力列舉的最小值相同 ---
+static bool CoverIsValid(const CoverProblem& p, const CoverResult& res) {
+    std::vector<uint64_t> covered((size_t)p.rowWords, 0);
+    int cost = 0;
+    for (int c : res.cols) {
+        for (int w = 0; w < p.rowWords; w++) covered[w] |= p.Col(c)[w];
+        cost += p.Cost(c);
+    }
+    for (int r = 0; r < p.numRows; r++) if (!((covered[r / 64] >> (r % 64)) & 1)) return false;
+    return cost == res.cost;
+}
+
+// 每列隨機 1–3 個質項，欄數小到可以暴力列舉
+static void RandomChart(std::mt19937& rng, CoverProblem& p) {
+    const int rows = 3 + (int)(rng() % 30), cols = 3 + (int)(rng() % 12);
+    p.Init(rows, cols);
+    for (int r = 0; r < rows; r++) {
+        const int k = 1 + (int)(rng() % 3);
+        for (int j = 0; j < k; j++) p.Set((int)(rng() % cols), r);
+    }
+}
+
+// 暴力列舉所有質項組合的最低成本，無解時為 -1；count 非空時一併數出最低成本的組合數
+static int BruteForceCover(const CoverProblem& p, int* count = nullptr) {
+    int best = -1, ways = 0;
+    for (uint32_t set = 0; set < (1u << p.numCols); set++) {
+        std::vector<uint64_t> covered((size_t)p.rowWords, 0);
+        int cost = 0;
+        for (int c = 0; c < p.numCols; c++) {
+            if (!((set >> c) & 1)) continue;
+            cost += p.Cost(c);
+            for (int w = 0; w < p.rowWords; w++) covered[w] |= p.Col(c)[w];
+        }
+        bool all = true;
+        for (int r = 0; r < p.numRows; r++) if (!((covered[r / 64] >> (r % 64)) & 1)) all = false;
+        if (!all) continue;
+        if (best < 0 || cost < best) best = cost, ways = 0;
+        if (cost == best) ways++;
+    }
+    if (count) *count = ways;
+    return best;
+}
+
+static void TestCover() {
+    std::mt19937 rng(3);
+    for (int it = 0; it < 300; it++) {
+        CoverProblem p;
+        RandomChart(rng, p);
+        const int best = BruteForceCover(p);
+        CoverOptions opts;
+        opts.method = CoverMethod::Greedy;
+        CoverResult greedy = SolveCover(p, opts);
+        opts.method = CoverMethod::Exact;
+        opts.parallel = false;
+        CoverResult exact = SolveCover(p, opts);
+        opts.method = CoverMethod::Sat;
+        CoverResult sat = SolveCover(p, opts);
+        Check(greedy.complete == (best >= 0), "greedy completeness", it);
+        if (best < 0) continue;
+        Check(CoverIsValid(p, greedy), "greedy cover", it);
+        Check(CoverIsValid(p, exact) && exact.optimal && exact.cost == best, "exact cover minimum", it);
+        Check(CoverIsValid(p, sat) && sat.optimal && sat.cost == best, "SAT cover minimum", it);
+    }
+}
+
+// --- 4 變數：貪婪法與精確法的框組合都正確，精確法不多於貪婪法 ---
+// 帶權重的覆蓋：精確法仍要等於暴力列舉的最低成本
+static void TestWeightedCover() {
+    std::mt19937 rng(12);
+    for (int it = 0; it < 300; it++) {
+        CoverProblem p;
+        RandomChart(rng, p);
+        for (int c = 0; c < p.numCols; c++) p.SetCost(c, 1 + (int)(rng() % 5));
+        const int best = BruteForceCover(p);
+        if (best < 0) continue;
+        CoverOptions opts;
+        opts.method = CoverMethod::Greedy;
+        Check(CoverIsValid(p, SolveCover(p, opts)), "weighted greedy cover", it);
+        opts.method = CoverMethod::Exact;
+        opts.parallel = false;
+        CoverResult exact = SolveCover(p, opts);
+        Check(CoverIsValid(p, exact) && exact.optimal && exact.cost == best, "weighted exact minimum", it);
+        opts.method = CoverMethod::Sat;
+        CoverResult sat = SolveCover(p, opts);
+        Check(CoverIsValid(p, sat) && sat.optimal && sat.cost == best, "weighted SAT minimum", it);
+    }
+}
+
+// 4 變數函數在成本模型下的最低成本：QM 質項當欄、TermCostUnder 當權重後暴力列舉 (質項太多時為 -1)
+static int BruteForceKMapCost(CellMask on, CellMask dc, CostModel model, int* count = nullptr) {
+    std::vector<uint32_t> onSet, dcSet;
+    for (uint32_t m = 0; m < 16; m++) {
+        if ((on >> m) & 1) onSet.push_back(m);
+        else if ((dc >> m) & 1) dcSet.push_back(m);
+    }
+    if (count) *count = 1;
+    if (onSet.empty()) return 0;
+    std::vector<Implicant> primes;
+    for (const Implicant& imp : GeneratePrimes(4, onSet, dcSet, false))
+        for (uint32_t m : onSet) if (imp.Covers(m)) { primes.push_back(imp); break; }
+    if (primes.size() > 16) return -1;
+    CoverProblem p;
+    p.Init((int)onSet.size(), (int)primes.size());
+    for (int c = 0; c < (int)primes.size(); c++) {
+        p.SetCost(c, TermCostUnder(4 - PopCount32(primes[c].mask), model));
+        for (int r = 0; r < (int)onSet.size(); r++) if (primes[c].Covers(onSet[r])) p.Set(c, r);
+    }
+    return BruteForceCover(p, count);
+}
+
+static void TestKMap() {
+    std::mt19937 rng(8);
+    for (int it = 0; it < 3000; it++) {
+        const CellMask on = (CellMask)rng(), dc = (CellMask)(rng() & rng() & ~on);
+        CoverOptions opts;
+        opts.costModel = (CostModel)(it % 3);
+        int cost[3];
+        for (int m = 0; m < 3; m++) {
+            opts.method = (CoverMethod)m;
+            CoverResult stats;
+            const std::vector<KMapGroup> groups = SolveKMapMask(on, dc, opts, &stats);
+            Check(VerifyKMapGroups(groups.data(), groups.size(), on, dc), "k-map cover", m);
+            cost[m] = stats.cost;
+        }
+        Check(cost[1] <= cost[0] && cost[1] == cost[2], "k-map exact cost", it);
+        if (it % 10 == 0) {
+            const int best = BruteForceKMapCost(on, dc, opts.costModel);
+            Check(best < 0 || cost[1] == best, "k-map exact minimum under cost model", it);
+        }
+    }
+}
+
+// --- Quine-McCluskey：質項與逐一列舉所有乘積項的結果相同，覆蓋有效且為最少項數 ---
+static std::vector<Implicant> BruteForcePrimes(int numVars, const std::vector<uint32_t>& onSet,
+                                               const std::vector<uint32_t>& dcSet) {
+    const uint32_t size = 1u << numVars;
+    std::vector<uint8_t> allowed(size, 0);
+    for (uint32_t m : onSet) allowed[m] = 1;
+    for (uint32_t m : dcSet) allowed[m] = 1;
+    auto isImplicant = [&](uint32_t value, uint32_t mask) {
+        for (uint32_t m = 0; m < size; m++) if ((m & ~mask) == value && !allowed[m]) return false;
+        return true;
+    };
+    std::vector<Implicant> primes;
+    for (uint32_t mask = 0; mask < size; mask++) {
+        for (uint32_t value = 0; value < size; value++) {
+            if ((value & mask) || !isImplicant(value, mask)) continue;
+            bool prime = true;
+            for (int b = 0; b < numVars && prime; b++) {
+                const uint32_t bit = 1u << b;
+                if (!(mask & bit) && isImplicant(value & ~bit, mask | bit)) prime = false;
+            }
+            if (prime) primes.push_back({ value, mask });
+        }
+    }
+    return primes;
+}
+
+static void TestQM() {
+    std::mt19937 rng(10);
+    for (int n = 1; n <= 6; n++) {
+        for (int it = 0; it < 40; it++) {
+            std::vector<uint32_t> onSet, dcSet;
+            RandomFunction(rng, n, (int)(rng() % 70), (int)(rng() % 20), onSet, dcSet);
+            const std::vector<Implicant> all = GeneratePrimes(n, onSet, dcSet, false);
+            Check(SortedKeys(all) == SortedKeys(BruteForcePrimes(n, onSet, dcSet)), "QM primes", n);
+
+            CoverOptions opts;
+            opts.method = CoverMethod::Exact;
+            opts.nodeLimit = 0;
+            const QMResult qm = SolveQM(n, onSet, dcSet, opts);
+            Check(VerifyCubes(qm.cover.data(), qm.cover.size(), TruthTable::FromMinterms(n, onSet),
+                              TruthTable::FromMinterms(n, dcSet)), "QM cover", n);
+            if (qm.primes.size() > 14) continue;
+            CoverProblem p;
+            p.Init((int)onSet.size(), (int)qm.primes.size());
+            for (size_t c = 0; c < qm.primes.size(); c++) {
+                for (size_t r = 0; r < onSet.size(); r++) if (qm.primes[c].Covers(onSet[r])) p.Set((int)c, (int)r);
+            }
+            Check((int)qm.cover.size() == std::max(BruteForceCover(p), 0), "QM cover minimum", n);
+        }
+    }
+}
+
+// --- Espresso：8–12 變數的隨機乘積項，SOP 與 POS 的結果都以真值表驗證且沒有多餘的項；20 變數在時間限制內 ---
+static CubeList RandomCubes(std::mt19937& rng, int numVars, int count, int freePercent) {
+    CubeList cubes;
+    for (int i = 0; i < count; i++) {
+        Cube c = CUBE_UNIVERSE;
+        for (int v = 0; v < numVars; v++) {
+            if ((int)(rng() % 100) >= freePercent) c &= CubeLiteral(v, (int)(rng() & 1));
+        }
+        cubes.push_back(CubeNormalize(c, numVars));
+    }
+    return cubes;
+}
+
+static std::vector<Implicant> ToImplicants(const CubeList& cubes, int numVars) {
+    std::vector<Implicant> terms;
+    for (Cube c : cubes) terms.push_back(CubeToImplicant(c, numVars));
+    return terms;
+}
+
+// POS 時 cover 覆蓋的是 0 的部分
+static bool EspressoCoverOk(const EspressoResult& res, int numVars, const TruthTable& on, const TruthTable& dc, bool isPOS) {
+    const std::vector<Implicant> terms = ToImplicants(res.cover, numVars);
+    const TruthTable target = isPOS ? ~(on | dc) : on;
+    return VerifyCubes(terms.data(), terms.size(), target, dc);
+}
+
+static void TestEspresso() {
+    std::mt19937 rng(12);
+    for (int it = 0; it < 60; it++) {
+        const int n = 8 + it % 5;
+        const CubeList onSet = RandomCubes(rng, n, 2 + (int)(rng() % 30), 50);
+        const CubeList dcSet = RandomCubes(rng, n, (int)(rng() % 4), 60);
+        const std::vector<Implicant> onTerms = ToImplicants(onSet, n), dcTerms = ToImplicants(dcSet, n);
+        // on-set 與 dc-set 重疊的部分是 don't care
+        const TruthTable dc = EvaluateCubes(n, dcTerms.data(), dcTerms.size());
+        const TruthTable on = EvaluateCubes(n, onTerms.data(), onTerms.size()) & ~dc;
+        for (int pos = 0; pos < 2; pos++) {
+            const EspressoResult res = Espresso(n, onSet, dcSet, pos != 0);
+            Check(EspressoCoverOk(res, n, on, dc, pos != 0), "espresso cover", it);
+            // 拿掉任何一項都不再是有效的覆蓋
+            const TruthTable target = pos ? ~(on | dc) : on;
+            bool irredundant = true;
+            for (size_t i = 0; i < res.cover.size() && irredundant; i++) {
+                CubeList rest = res.cover;
+                rest.erase(rest.begin() + i);
+                const std::vector<Implicant> terms = ToImplicants(rest, n);
+                if (VerifyCubes(terms.data(), terms.size(), target, dc)) irredundant = false;
+            }
+            Check(irredundant, "espresso irredundant", it);
+        }
+    }
+
+    // 20 變數、50 個乘積項的 PLA：POS 的補數有數百項，REDUCE / IRREDUNDANT 不可退化成逐項複製整個列表
+    const int n = 20;
+    const CubeList onSet = RandomCubes(rng, n, 50, 33);
+    const std::vector<Implicant> onTerms = ToImplicants(onSet, n);
+    const TruthTable on = EvaluateCubes(n, onTerms.data(), onTerms.size()), dc(n);
+    const auto start = std::chrono::steady_clock::now();
+    for (int pos = 0; pos < 2; pos++) {
+        const EspressoResult res = Espresso(n, onSet, CubeList(), pos != 0);
+        Check(EspressoCoverOk(res, n, on, dc, pos != 0), "espresso 20-input cover", pos);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Check(ms < 3000.0, "espresso 20-input time (ms)", (int)ms);
+}
+
+// --- 執行緒池：巢狀 ParallelFor 每個工作恰好執行一次；平行與單執行緒的 QM 質項相同 ---
+static void TestThreadPool() {
+    ThreadPool pool(4);
+    for (int it = 0; it < 200; it++) {
+        const size_t outer = 1 + it % 7, inner = 1 + it % 13;
+        std::vector<std::atomic<int>> hits(outer * inner);
+        for (auto& h : hits) h = 0;
+        pool.ParallelFor(outer, [&](size_t i) {
+            pool.ParallelFor(inner, [&](size_t j) { hits[i * inner + j]++; });
+        });
+        bool once = true;
+        for (auto& h : hits) if (h != 1) once = false;
+        Check(once, "parallel for", it);
+    }
+
+    std::mt19937 rng(14);
+    for (int n = 6; n <= 12; n++) {
+        for (int it = 0; it < 4; it++) {
+            std::vector<uint32_t> onSet, dcSet;
+            RandomFunction(rng, n, 20 + (int)(rng() % 50), (int)(rng() % 20), onSet, dcSet);
+            Check(SortedKeys(GeneratePrimes(n, onSet, dcSet, true)) == SortedKeys(GeneratePrimes(n, onSet, dcSet, false)),
+                  "parallel QM primes", n);
+        }
+    }
+}
+
+// --- 位元陣列核心：每個支援的版本與逐字的參考結果相同 ---
+static void TestBitsetKernels() {
+    std::mt19937_64 rng(2);
+    const BitsetLevel original = GetBitsetLevel();
+    for (BitsetLevel level : { BitsetLevel::Scalar, BitsetLevel::Sse42, BitsetLevel::Avx2 }) {
+        if (!SetBitsetLevel(level)) continue;
+        for (int it = 0; it < 3000; it++) {
+            const size_t n = (size_t)(it % 21);
+            std::vector<uint64_t> a(n), b(n), mask(n);
+            for (size_t i = 0; i < n; i++) {
+                a[i] = rng() & rng();
+                mask[i] = (it % 2) ? (rng() | rng()) : (rng() & rng());
+                // 三分之一的情況 mask 內包含、mask 外不包含，檢查 mask 確實有作用
+                b[i] = (it % 3 == 0) ? ((a[i] & mask[i]) | (rng() & rng())) : rng();
+            }
+            int count = 0, countAnd = 0;
+            bool subset = true, intersect = false;
+            for (size_t i = 0; i < n; i++) {
+                count += PopCount64(a[i]);
+                countAnd += PopCount64(a[i] & b[i]);
+                if (a[i] & mask[i] & ~b[i]) subset = false;
+                if (a[i] & b[i] & mask[i]) intersect = true;
+            }
+            Check(BitsCount(a.data(), n) == count, "BitsCount", (int)level);
+            Check(BitsCountAnd(a.data(), b.data(), n) == countAnd, "BitsCountAnd", (int)level);
+            Check(BitsSubsetWithin(a.data(), b.data(), mask.data(), n) == subset, "BitsSubsetWithin", (int)level);
+            Check(BitsIntersect(a.data(), b.data(), mask.data(), n) == intersect, "BitsIntersect", (int)level);
+            std::vector<uint64_t> c = a;
+            BitsAndNot(c.data(), b.data(), n);
+            for (size_t i = 0; i < n; i++) Check(c[i] == (a[i] & ~b[i]), "BitsAndNot", (int)level);
+        }
+    }
+    SetBitsetLevel(original);
+}
+
+// --- 增量化簡：逐格 / 批次修改後的質項與完整重算相同，覆蓋有效 ---
+static void TestIncremental() {
+    std::mt19937 rng(6);
+    for (int n = 1; n <= 9; n++) {
+        for (int it = 0; it < 12; it++) {
+            const uint32_t size = 1u << n;
+            std::vector<int> role(size);
+            for (uint32_t m = 0; m < size; m++) role[m] = (int)(rng() % 3);
+            std::vector<uint32_t> onSet, dcSet;
+            auto collect = [&]() {
+                onSet.clear();
+                dcSet.clear();
+                for (uint32_t m = 0; m < size; m++) {
+                    if (role[m] == (int)CellRole::On) onSet.push_back(m);
+                    else if (role[m] == (int)CellRole::DontCare) dcSet.push_back(m);
+                }
+            };
+            collect();
+            IncrementalSolver solver;
+            solver.Solve(n, onSet, dcSet);
+            for (int step = 0; step < 60; step++) {
+                const int edits = (rng() % 10 == 0) ? 1 + (int)(rng() % 30) : 1;
+                for (int e = 0; e < edits; e++) role[rng() % size] = (int)(rng() % 3);
+                collect();
+                if (step % 2) {
+                    solver.Update(onSet, dcSet);
+                } else {
+                    for (uint32_t m = 0; m < size; m++) {
+                        if ((int)solver.Role(m) != role[m]) solver.SetCell(m, (CellRole)role[m]);
+                    }
+                }
+                Check(SortedKeys(solver.Primes()) == SortedKeys(GeneratePrimes(n, onSet, dcSet, false)),
+                      "incremental primes", n);
+                const std::vector<Implicant>& cover = solver.Cover();
+                Check(VerifyCubes(cover.data(), cover.size(), TruthTable::FromMinterms(n, onSet),
+                                  TruthTable::FromMinterms(n, dcSet)), "incremental cover", n);
+            }
+        }
+    }
+}
+
+// --- 背景化簡：連續送出大量工作，最後拿到的是最後一次送出的結果 ---
+static void TestSolverWorker() {
+    std::mt19937 rng(9);
+    SolverWorker worker(nullptr);
+    CoverOptions opts;
+    opts.method = CoverMethod::Exact;
+    for (int burst = 0; burst < 20; burst++) {
+        int data[4][4];
+        for (int k = 0; k < 50; k++) {
+            for (int r = 0; r < 4; r++) for (int c = 0; c < 4; c++) data[r][c] = (int)(rng() % 3);
+            worker.Submit(data, VAL_1, opts);
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (worker.Busy() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::vector<KMapGroup> groups;
+        Check(worker.Poll(groups), "worker result", burst);
+        CellMask on, dc;
+        GridToMasks(data, VAL_1, on, dc);
+        Check(VerifyKMapGroups(groups.data(), groups.size(), on, dc), "worker latest result", burst);
+        Check(groups.size() == SolveKMap(data, VAL_1, opts).size(), "worker result size", burst);
+    }
+}
+
+// --- 化簡結果快取：LRU 與逐項搬移的參考模型相同，SolveKMapCached 與直接化簡的結果相同 ---
+static std::vector<KMapGroup> TaggedGroups(uint64_t key) {
+    std::vector<KMapGroup> groups(1 + key % 3);
+    for (size_t i = 0; i < groups.size(); i++) groups[i].rect = (int)(key * 7 + i);
+    return groups;
+}
+
+static void TestSolutionCache() {
+    std::mt19937 rng(15);
+    for (int it = 0; it < 50; it++) {
+        const size_t capacity = 1 + it % 8;
+        SolutionCache cache(capacity);
+        std::vector<uint64_t> model; // 前端為最近使用
+        SolutionCacheStats expected;
+        for (int op = 0; op < 300; op++) {
+            const uint64_t key = rng() % 12;
+            auto found = std::find(model.begin(), model.end(), key);
+            if (rng() & 1) {
+                cache.Store(key, TaggedGroups(key), CoverResult());
+                if (found != model.end()) model.erase(found);
+                model.insert(model.begin(), key);
+                if (model.size() > capacity) { model.pop_back(); expected.evictions++; }
+            } else {
+                std::vector<KMapGroup> groups;
+                const bool hit = cache.Lookup(key, groups);
+                Check(hit == (found != model.end()), "cache hit", it);
+                if (found == model.end()) { expected.misses++; continue; }
+                expected.hits++;
+                Check(groups == TaggedGroups(key), "cache entry", it);
+                model.erase(found);
+                model.insert(model.begin(), key);
+            }
+        }
+        const SolutionCacheStats stats = cache.Stats();
+        Check(stats.hits == expected.hits && stats.misses == expected.misses && stats.evictions == expected.evictions &&
+              stats.size == model.size(), "cache stats", it);
+    }
+
+    // 只差 SOP / POS 或覆蓋方法的格子不可共用 key；第二次查詢命中且結果與直接化簡相同
+    SolutionCache cache(64);
+    CoverOptions opts;
+    for (int it = 0; it < 200; it++) {
+        int data[4][4];
+        for (int r = 0; r < 4; r++) for (int c = 0; c < 4; c++) data[r][c] = (int)(rng() % 3);
+        const int targetVal = (it & 1) ? VAL_0 : VAL_1;
+        opts.method = (it & 2) ? CoverMethod::Exact : CoverMethod::Greedy;
+        CellMask on, dc;
+        GridToMasks(data, targetVal, on, dc);
+        const uint64_t key = SolutionCache::MakeKey(on, dc, targetVal, opts);
+        CoverOptions other = opts;
+        other.method = (it & 2) ? CoverMethod::Greedy : CoverMethod::Exact;
+        Check(key != SolutionCache::MakeKey(on, dc, targetVal == VAL_1 ? VAL_0 : VAL_1, opts) &&
+              key != SolutionCache::MakeKey(on, dc, targetVal, other), "cache key", it);
+
+        const std::vector<KMapGroup> direct = SolveKMap(data, targetVal, opts);
+        for (int pass = 0; pass < 2; pass++) {
+            const uint64_t hits = cache.Stats().hits;
+            const std::vector<KMapGroup> cached = SolveKMapCached(data, targetVal, opts, nullptr, cache);
+            Check(cached == direct, "cached solve", it);
+            if (pass == 1) Check(cache.Stats().hits == hits + 1, "cached solve hit", it);
+        }
+    }
+}
+
+// --- NPN 解答庫：384 種轉換與真值表的排列 / 反相相同，反轉換與框的轉換一致，正規形在轉換下不變 ---
+static void TestNpnTransforms() {
+    std::mt19937 rng(16);
+    int perms[24][4], permCount = 0;
+    for (int a = 0; a < 4; a++) for (int b = 0; b < 4; b++) for (int c = 0; c < 4; c++) for (int d = 0; d < 4; d++) {
+        if (a == b || a == c || a == d || b == c || b == d || c == d) continue;
+        perms[permCount][0] = a; perms[permCount][1] = b; perms[permCount][2] = c; perms[permCount][3] = d;
+        permCount++;
+    }
+    for (int t = 0; t < NPN_TRANSFORM_COUNT; t++) {
+        for (int k = 0; k < 20; k++) {
+            const CellMask m = (CellMask)rng();
+            TruthTable x = TruthTable::FromCellMask(m);
+            x.ApplyNpn(perms[t / 16], t % 16, false);
+            Check(x.ToCellMask() == ApplyNpnTransform(t, m), "NPN transform table", t);
+            Check(ApplyNpnTransform(InverseNpnTransform(t), ApplyNpnTransform(t, m)) == m, "NPN inverse", t);
+        }
+        for (int r = 0; r < IMPLICANT_COUNT; r++) {
+            Check(IMPLICANT_TABLE.rects[TransformRect(t, r)].mask == ApplyNpnTransform(t, IMPLICANT_TABLE.rects[r].mask),
+                  "NPN rect transform", t);
+        }
+    }
+    for (int it = 0; it < 500; it++) {
+        const CellMask on = (CellMask)rng(), dc = (CellMask)(rng() & rng() & ~on);
+        const NpnCanonical canon = CanonicalizeKMap(on, dc);
+        const uint32_t key = ApplyNpnTransform(canon.transform, on) | (uint32_t)ApplyNpnTransform(canon.transform, dc) << 16;
+        Check(key == canon.key, "NPN canonical transform", it);
+        const int t = (int)(rng() % NPN_TRANSFORM_COUNT);
+        Check(CanonicalizeKMap(ApplyNpnTransform(t, on), ApplyNpnTransform(t, dc)).key == canon.key, "NPN canonical key", it);
+    }
+}
+
+// --- 不配置記憶體的化簡路徑：SolverContext 的結果與一般版本相同，暖機後不再配置記憶體 ---
+static void TestSolverContext() {
+    std::mt19937 rng(17);
+    for (int m = 0; m < 2; m++) {
+        CoverOptions opts;
+        opts.method = (CoverMethod)m;
+        SolverContext ctx;
+        for (int it = 0; it < 2000; it++) {
+            const CellMask on = (CellMask)rng(), dc = (CellMask)(rng() & rng() & ~on);
+            const GroupList& groups = SolveKMapMask(ctx, on, dc, opts);
+            const std::vector<KMapGroup> expected = SolveKMapMask(on, dc, opts);
+            Check(std::vector<KMapGroup>(groups.begin(), groups.end()) == expected, "SolverContext result", m);
+        }
+        for (int i = 0; i < 65536; i++) SolveKMapMask(ctx, (CellMask)i, (CellMask)(rng() & rng() & ~i), opts);
+        const size_t before = allocationCount;
+        for (int i = 0; i < 5000; i++) {
+            const CellMask on = (CellMask)rng();
+            SolveKMapMask(ctx, on, (CellMask)(rng() & rng() & ~on), opts);
+        }
+        Check(allocationCount == before, "SolverContext steady-state allocations", m);
+    }
+}
+
+// --- SOP / POS 同時化簡：兩邊與分別化簡的結果相同，選出的一邊成本不高於另一邊 ---
+static void TestDual() {
+    std::mt19937 rng(18);
+    SolverContext ctx;
+    for (int it = 0; it < 3000; it++) {
+        const CellMask on = (CellMask)rng(), dc = (CellMask)(rng() & rng() & ~on);
+        const CellMask off = (CellMask)(~on & ~dc);
+        CoverOptions opts;
+        opts.method = (CoverMethod)(it % 2);
+        DualSolution dual;
+        SolveKMapDual(ctx, on, dc, opts, dual);
+        Check(std::vector<KMapGroup>(dual.sop.begin(), dual.sop.end()) == SolveKMapMask(on, dc, opts), "dual SOP", it);
+        Check(std::vector<KMapGroup>(dual.pos.begin(), dual.pos.end()) == SolveKMapMask(off, dc, opts), "dual POS", it);
+        Check(VerifyKMapGroups(dual.sop.data(), dual.sop.size(), on, dc) &&
+              VerifyKMapGroups(dual.pos.data(), dual.pos.size(), off, dc), "dual covers", it);
+        const FormCost& chosen = dual.posCheaper ? dual.posCost : dual.sopCost;
+        const FormCost& other = dual.posCheaper ? dual.sopCost : dual.posCost;
+        Check(!other.Cheaper(chosen, opts.costModel), "dual cheapest form", it);
+    }
+}
+
+// --- Dancing Links：列舉出的覆蓋彼此不同、都是最低成本，數量與暴力列舉相同 ---
+static void TestCoverEnumerator() {
+    std::mt19937 rng(15);
+    for (int it = 0; it < 300; it++) {
+        CoverProblem p;
+        RandomChart(rng, p);
+        if (it % 2) for (int c = 0; c < p.numCols; c++) p.SetCost(c, 1 + (int)(rng() % 5));
+        int ways = 0;
+        const int best = BruteForceCover(p, &ways);
+        CoverOptions opts;
+        opts.parallel = false;
+        CoverEnumerator e(p, opts);
+        std::vector<int> cols;
+        std::vector<uint32_t> seen;
+        while (e.Next(cols)) {
+            CoverResult res;
+            res.cols = cols;
+            res.cost = best;
+            Check(std::is_sorted(cols.begin(), cols.end()) && CoverIsValid(p, res), "enumerated cover minimum", it);
+            uint32_t set = 0;
+            for (int c : cols) set |= 1u << c;
+            seen.push_back(set);
+        }
+        Check(e.Complete() == (best >= 0), "enumerator completeness", it);
+        if (best < 0) continue;
+        Check(e.Optimal() && e.MinCost() == best && e.Count() == seen.size(), "enumerator min cost", it);
+        std::sort(seen.begin(), seen.end());
+        Check(std::unique(seen.begin(), seen.end()) == seen.end(), "enumerated covers distinct", it);
+        Check((int)seen.size() == ways, "enumerated cover count", it);
+
+        CoverEnumerator limited(p, opts, 2);
+        size_t count = 0;
+        while (limited.Next(cols)) count++;
+        Check(count == std::min<size_t>(2, (size_t)ways), "enumerator limit", it);
+    }
+
+    // 卡諾圖：每一組框都覆蓋函數，成本等於 MinCost
+    for (int it = 0; it < 500; it++) {
+        const CellMask on = (CellMask)rng(), dc = (CellMask)(rng() & rng() & ~on);
+        CoverOptions opts;
+        opts.costModel = (CostModel)(it % 3);
+        int ways = 0;
+        const int best = BruteForceKMapCost(on, dc, opts.costModel, &ways);
+        KMapSolutionEnumerator e(on, dc, opts);
+        std::vector<KMapGroup> groups;
+        int count = 0;
+        while (e.Next(groups)) {
+            int cost = 0;
+            for (const KMapGroup& g : groups) cost += GroupCostUnder(g, opts.costModel);
+            Check(VerifyKMapGroups(groups.data(), groups.size(), on, dc) && cost == e.MinCost(), "k-map enumerated cover", it);
+            count++;
+        }
+        Check(best < 0 || (e.MinCost() == best && count == ways), "k-map enumerated count", it);
+    }
+}
+
+// --- ISOP：覆蓋正確，且拿掉任何一項或任何一個字母都不再正確 ---
+static void TestIsop() {
+    std::mt19937 rng(17);
+    for (int it = 0; it < 400; it++) {
+        const int n = (int)(it % 11);
+        std::vector<uint32_t> onSet, dcSet;
+        RandomFunction(rng, n, 10 + (int)(rng() % 60), (int)(rng() % 30), onSet, dcSet);
+        TruthTable on(n), dc(n);
+        for (uint32_t m : onSet) on.Set(m);
+        for (uint32_t m : dcSet) dc.Set(m);
+        TruthTable f;
+        std::vector<Implicant> cubes = Isop(on, dc, &f);
+        Check(VerifyCubes(cubes.data(), cubes.size(), on, dc), "isop cover", it);
+        Check(f == EvaluateCubes(n, cubes.data(), cubes.size()), "isop cover table", it);
+        Check(SortedKeys(SolveIsop(n, onSet, dcSet)) == SortedKeys(cubes), "solve isop", it);
+
+        bool irredundant = true;
+        for (size_t i = 0; i < cubes.size(); i++) {
+            std::vector<Implicant> rest = cubes;
+            rest.erase(rest.begin() + (long)i);
+            if (VerifyCubes(rest.data(), rest.size(), on, dc)) irredundant = false;
+            for (int v = 0; v < n; v++) {
+                const uint32_t bit = 1u << v;
+                if (cubes[i].mask & bit) continue;
+                rest = cubes;
+                rest[i].mask |= bit;
+                rest[i].value &= ~bit;
+                if (VerifyCubes(rest.data(), rest.size(), on, dc)) irredundant = false;
+            }
+        }
+        Check(irredundant, "isop irredundant", it);
+    }
+    Check(SolveIsop(-1, { 0 }, {}).empty(), "isop negative vars");
+    Check(SolveIsop(TRUTH_TABLE_MAX_VARS + 1, { 0 }, {}).empty(), "isop too many vars");
+}
+
+// --- N 變數卡諾圖：質項與 QM 相同、精確覆蓋的項數與 QM 相同，繪圖段拼回框的格子 ---
+template <int N>
+static void TestKMapOf(std::mt19937& rng) {
+    typedef KMap<N> Map;
+    for (int it = 0; it < 200; it++) {
+        const uint64_t on = ((uint64_t)rng() << 32 | rng()) & Map::FULL;
+        const uint64_t dc = (uint64_t)rng() & rng() & ~on & Map::FULL;
+        std::vector<uint32_t> onSet, dcSet;
+        for (uint32_t m = 0; m < (uint32_t)Map::CELLS; m++) {
+            if ((on >> m) & 1) onSet.push_back(m);
+            else if ((dc >> m) & 1) dcSet.push_back(m);
+        }
+
+        std::vector<KMapTerm> primes;
+        Map::Primes((typename Map::Mask)on, (typename Map::Mask)dc, primes);
+        std::vector<Implicant> asImplicants;
+        for (const KMapTerm& t : primes) asImplicants.push_back({ t.value, ~t.care & Map::VARS });
+        CoverOptions opts;
+        opts.method = CoverMethod::Exact;
+        opts.parallel = false;
+        const QMResult qm = SolveQM(N, onSet, dcSet, opts);
+        Check(SortedKeys(asImplicants) == SortedKeys(qm.primes), "kmap<N> primes", N);
+
+        std::vector<KMapTerm> terms;
+        CoverResult stats;
+        Check(SolveKMapN(N, on, dc, opts, terms, &stats), "kmap<N> dispatch", N);
+        uint64_t covered = 0;
+        for (const KMapTerm& t : terms) {
+            Check(t.mask == Map::CubeCells(t.care, t.value), "kmap<N> term cells", N);
+            covered |= t.mask;
+        }
+        Check((covered & on) == on && (covered & ~(on | dc)) == 0, "kmap<N> cover", N);
+        if (stats.optimal && qm.stats.optimal) Check(terms.size() == qm.cover.size(), "kmap<N> exact vs qm", N);
+
+        for (const KMapTerm& t : primes) {
+            KMapSegment seg[Map::MAX_SEGMENTS];
+            const int count = KMapSegmentsN(N, t, seg);
+            uint64_t cells = 0;
+            int area = 0;
+            bool inside = count >= 1 && count <= Map::MAX_SEGMENTS;
+            for (int i = 0; i < count; i++) {
+                inside = inside && seg[i].r + seg[i].h <= Map::ROWS && seg[i].c + seg[i].w <= Map::COLS;
+                for (int r = seg[i].r; r < seg[i].r + seg[i].h; r++)
+                    for (int c = seg[i].c; c < seg[i].c + seg[i].w; c++) cells |= 1ull << Map::CellBit(r, c);
+                area += seg[i].w * seg[i].h;
+            }
+            Check(inside && cells == t.mask && area == PopCount64(t.mask), "kmap<N> segments", N);
+        }
+    }
+}
+
+static void TestKMapTemplate() {
+    std::mt19937 rng(19);
+    TestKMapOf<2>(rng);
+    TestKMapOf<3>(rng);
+    TestKMapOf<4>(rng);
+    TestKMapOf<5>(rng);
+    TestKMapOf<6>(rng);
+
+    std::vector<KMapTerm> terms;
+    KMapSegment seg[1];
+    Check(!SolveKMapN(1, 1, 0, CoverOptions(), terms) && !SolveKMapN(7, 1, 0, CoverOptions(), terms), "kmap<N> range");
+    Check(KMapSegmentsN(7, KMapTerm{ 0, 0, 1 }, seg) == 0, "kmap<N> segments range");
+}
+
+// --- Consensus：質項與 QM 中和 on-set 相交的質項相同，最小覆蓋的項數相同 ---
+static void TestConsensus() {
+    std::mt19937 rng(21);
+    for (int n = 1; n <= 8; n++) {
+        for (int it = 0; it < 25; it++) {
+            std::vector<uint32_t> onSet, dcSet;
+            RandomFunction(rng, n, (int)(rng() % 60), (int)(rng() % 20), onSet, dcSet);
+            std::vector<Implicant> useful;
+            for (const Implicant& p : GeneratePrimes(n, onSet, dcSet, false)) {
+                for (uint32_t m : onSet) if (p.Covers(m)) { useful.push_back(p); break; }
+            }
+            CoverOptions exact;
+            exact.method = CoverMethod::Exact;
+            exact.nodeLimit = 0;
+            const QMResult consensus = SolveConsensus(n, onSet, dcSet, exact);
+            const QMResult qm = SolveQM(n, onSet, dcSet, exact);
+            Check(SortedKeys(consensus.primes) == SortedKeys(useful), "consensus primes", n);
+            Check(consensus.cover.size() == qm.cover.size(), "consensus cover size", n);
+            const TruthTable on = TruthTable::FromMinterms(n, onSet), dc = TruthTable::FromMinterms(n, dcSet);
+            Check(VerifyCubes(consensus.cover.data(), consensus.cover.size(), on, dc), "consensus cover", n);
+        }
+    }
+
+    // 大空間中的稀疏函數：只驗證覆蓋
+    for (int it = 0; it < 10; it++) {
+        const int n = 16 + it % 5;
+        std::vector<uint32_t> onSet, dcSet;
+        for (int k = 0; k < 40; k++) ((rng() % 4) ? onSet : dcSet).push_back((uint32_t)rng() & ((1u << n) - 1));
+        const QMResult consensus = SolveConsensus(n, onSet, dcSet);
+        const TruthTable on = TruthTable::FromMinterms(n, onSet), dc = TruthTable::FromMinterms(n, dcSet);
+        Check(VerifyCubes(consensus.cover.data(), consensus.cover.size(), on, dc & ~on), "sparse consensus cover", n);
+    }
+    Check(SolveConsensus(0, { 0 }, {}).primes.empty() && SolveConsensus(CONSENSUS_MAX_VARS + 1, { 0 }, {}).primes.empty(),
+          "consensus range");
+}
+
+// --- 平行分支定界：大型表上與序列搜尋選出同一組質項 ---
+static void TestParallelCover() {
+    std::mt19937 rng(22);
+    for (int it = 0; it < 6; it++) {
+        const int rows = 80 + (int)(rng() % 40), cols = 60 + (int)(rng() % 40);
+        CoverProblem p;
+        p.Init(rows, cols);
+        for (int r = 0; r < rows; r++) for (int j = 0; j < 3; j++) p.Set((int)(rng() % cols), r);
+        if (it % 2) for (int c = 0; c < cols; c++) p.SetCost(c, 1 + (int)(rng() % 5));
+        CoverOptions opts;
+        opts.method = CoverMethod::Exact;
+        opts.nodeLimit = 20000;
+        opts.parallel = false;
+        CoverResult serial = SolveCover(p, opts);
+        opts.parallel = true;
+        CoverResult parallel = SolveCover(p, opts);
+        Check(CoverIsValid(p, parallel), "parallel cover", it);
+        if (serial.optimal && parallel.optimal) Check(serial.cols == parallel.cols, "parallel cover matches serial", it);
+    }
+
+    // 事先取消：仍回傳完整的覆蓋，但不標示為最佳
+    CoverProblem p;
+    p.Init(400, 200);
+    for (int r = 0; r < 400; r++) for (int j = 0; j < 3; j++) p.Set((int)(rng() % 200), r);
+    std::atomic<bool> cancel{ true };
+    CoverOptions opts;
+    opts.method = CoverMethod::Exact;
+    opts.nodeLimit = 0;
+    opts.cancel = &cancel;
+    CoverResult cancelled = SolveCover(p, opts);
+    Check(CoverIsValid(p, cancelled) && !cancelled.optimal, "parallel cover cancel");
+}
+
+// --- BDD / ZDD：隱式質項與 QM 相同，BDD 覆蓋正確且只用質項 ---
+static void TestBdd() {
+    std::mt19937 rng(23);
+    for (int n = 1; n <= 8; n++) {
+        for (int it = 0; it < 25; it++) {
+            std::vector<uint32_t> onSet, dcSet;
+            RandomFunction(rng, n, (int)(rng() % 60), (int)(rng() % 20), onSet, dcSet);
+            const std::vector<Implicant> all = GeneratePrimes(n, onSet, dcSet, false);
+
+            BddManager mgr(n, 10);
+            std::vector<uint32_t> upper = onSet;
+            upper.insert(upper.end(), dcSet.begin(), dcSet.end());
+            const BddRef f = mgr.Ref(mgr.FromMinterms(upper));
+            const BddRef primes = mgr.Ref(mgr.Primes(f));
+            std::vector<Implicant> zdd;
+            for (Cube c : mgr.ZddCubes(primes)) zdd.push_back(CubeToImplicant(c, n));
+            Check(SortedKeys(zdd) == SortedKeys(all), "ZDD primes", n);
+            Check(mgr.ZddCount(primes) == (double)all.size() && mgr.SatCount(f) == (double)upper.size(), "BDD counts", n);
+
+            const TruthTable on = TruthTable::FromMinterms(n, onSet), dc = TruthTable::FromMinterms(n, dcSet);
+            CubeList onCubes, dcCubes;
+            for (uint32_t m : onSet) onCubes.push_back(CubeFromImplicant({ m, 0 }, n));
+            for (uint32_t m : dcSet) dcCubes.push_back(CubeFromImplicant({ m, 0 }, n));
+            std::vector<Implicant> cover;
+            for (Cube c : SolveBdd(n, onCubes, dcCubes)) cover.push_back(CubeToImplicant(c, n));
+            Check(VerifyCubes(cover.data(), cover.size(), on, dc), "BDD cover", n);
+            const std::vector<uint64_t> primeKeys = SortedKeys(all);
+            bool allPrime = true;
+            for (const Implicant& c : cover) allPrime = allPrime && std::binary_search(primeKeys.begin(), primeKeys.end(), c.Key());
+            Check(allPrime, "BDD cover uses primes", n);
+        }
+    }
+
+    Check(SolveBdd(0, { 0 }, {}).empty() && SolveBdd(BDD_MAX_VARS + 1, { 0 }, {}).empty(), "BDD range");
+}
+
+// --- 多輸出：每個輸出的覆蓋正確，多輸出質項的輸出標記正確且不能再放大，共用後不比各自化簡差 ---
+static void TestMultiOutput() {
+    std::mt19937 rng(24);
+    for (int it = 0; it < 60; it++) {
+        const int n = 2 + (int)(rng() % 5), outputs = 1 + (int)(rng() % 4);
+        std::vector<std::vector<uint32_t>> onSets(outputs), dcSets(outputs);
+        std::vector<TruthTable> on, dc, upper;
+        for (int o = 0; o < outputs; o++) {
+            RandomFunction(rng, n, 40, 10, onSets[o], dcSets[o]);
+            on.push_back(TruthTable::FromMinterms(n, onSets[o]));
+            dc.push_back(TruthTable::FromMinterms(n, dcSets[o]));
+            upper.push_back(on[o] | dc[o]);
+        }
+        // 乘積項整個落在 on ∪ dc 內的輸出集合
+        auto fits = [&](const Implicant& imp) {
+            const TruthTable f = EvaluateCubes(n, &imp, 1);
+            uint32_t set = 0;
+            for (int o = 0; o < outputs; o++) if ((f & upper[o]) == f) set |= 1u << o;
+            return set;
+        };
+
+        CoverOptions opts;
+        opts.method = CoverMethod::Exact;
+        opts.parallel = false;
+        const MultiOutputResult res = SolveMultiOutput(n, onSets, dcSets, opts);
+        bool primesOk = true;
+        for (const MultiOutputTerm& p : res.primes) {
+            primesOk = primesOk && p.outputs != 0 && fits(p.term) == p.outputs;
+            for (int v = 0; v < n; v++) {
+                if (p.term.mask & (1u << v)) continue;
+                const Implicant bigger = { p.term.value & ~(1u << v), p.term.mask | (1u << v) };
+                primesOk = primesOk && (fits(bigger) & p.outputs) != p.outputs;
+            }
+        }
+        Check(primesOk, "multi-output primes", it);
+
+        int separate = 0;
+        size_t separateTerms = 0;
+        bool allOptimal = res.stats.optimal;
+        for (int o = 0; o < outputs; o++) {
+            const std::vector<Implicant> cover = res.OutputCover(o);
+            Check(VerifyCubes(cover.data(), cover.size(), on[o], dc[o]), "multi-output cover", it);
+            const QMResult qm = SolveQM(n, onSets[o], dcSets[o], opts);
+            separate += qm.stats.cost;
+            separateTerms += qm.cover.size();
+            allOptimal = allOptimal && qm.stats.optimal;
+        }
+        if (allOptimal) Check(res.stats.cost <= separate, "multi-output sharing", it);
+        if (outputs == 1 && allOptimal) Check(res.terms.size() == separateTerms, "single output matches QM", it);
+    }
+}
+
+// --- CDCL SAT：隨機 3-SAT 與暴力列舉的結果相同，覆蓋的衝突上限與取消 ---
+static void TestSatSolver() {
+    std::mt19937 rng(4);
+    for (int it = 0; it < 300; it++) {
+        const int n = 8 + (int)(rng() % 9);
+        const int m = (int)(4.26 * n);
+        std::vector<SatLit> lits((size_t)m * 3);
+        SatSolver solver;
+        for (int v = 0; v < n; v++) solver.NewVar();
+        for (int c = 0; c < m; c++) {
+            for (int j = 0; j < 3; j++) lits[c * 3 + j] = MakeLit((int)(rng() % n), rng() & 1);
+            solver.AddClause(&lits[c * 3], 3);
+        }
+        auto satisfied = [&](auto value) {
+            for (int c = 0; c < m; c++) {
+                bool any = false;
+                for (int j = 0; j < 3; j++) {
+                    const SatLit l = lits[c * 3 + j];
+                    if (value(LitVar(l)) != ((l & 1) != 0)) any = true;
+                }
+                if (!any) return false;
+            }
+            return true;
+        };
+        bool expected = false;
+        for (uint32_t a = 0; a < (1u << n) && !expected; a++) {
+            expected = satisfied([a](int v) { return ((a >> v) & 1) != 0; });
+        }
+        const SatStatus status = solver.Solve();
+        Check((status == SatStatus::Sat) == expected, "SAT status", it);
+        if (status == SatStatus::Sat) Check(satisfied([&](int v) { return solver.Value(v); }), "SAT model", it);
+    }
+
+    CoverProblem p;
+    p.Init(400, 200);
+    for (int r = 0; r < 400; r++) for (int j = 0; j < 3; j++) p.Set((int)(rng() % 200), r);
+    CoverOptions opts;
+    opts.method = CoverMethod::Sat;
+    opts.conflictLimit = 500;
+    CoverResult limited = SolveCover(p, opts);
+    Check(CoverIsValid(p, limited) && limited.nodes <= 500, "SAT conflict limit");
+    std::atomic<bool> cancel{ true };
+    opts.conflictLimit = 0;
+    opts.cancel = &cancel;
+    CoverResult cancelled = SolveCover(p, opts);
+    Check(CoverIsValid(p, cancelled) && !cancelled.optimal, "SAT cancel");
+}
+
+int main() {
+    struct Test {
+        const char* name;
+        void (*run)();
+    };
+    const Test tests[] = {
+        { "truth_table", TestTruthTable },
+        { "cover", TestCover },
+        { "weighted_cover", TestWeightedCover },
+        { "kmap", TestKMap },
+        { "qm", TestQM },
+        { "espresso", TestEspresso },
+        { "thread_pool", TestThreadPool },
+        { "bitset_kernels", TestBitsetKernels },
+        { "incremental", TestIncremental },
+        { "solver_worker", TestSolverWorker },
+        { "solution_cache", TestSolutionCache },
+        { "npn", TestNpnTransforms },
+        { "solver_context", TestSolverContext },
+        { "dual", TestDual },
+        { "dancing_links", TestCoverEnumerator },
+        { "isop", TestIsop },
+        { "kmap_template", TestKMapTemplate },
+        { "consensus", TestConsensus },
+        { "parallel_cover", TestParallelCover },
+        { "bdd", TestBdd },
+        { "multi_output", TestMultiOutput },
+        { "sat", TestSatSolver },
+    };
+    for (const Test& test : tests) {
+        const int before = failures;
+        const auto start = std::chrono::steady_clock::now();
+        test.run();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("%-18s %s (%.0f ms)\n", test.name, failures == before ? "ok" : "FAILED", ms);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include "solver_worker.h"
+#include "verifier.h"
+#include <cstring>
+
+SolverWorker::SolverWorker(SolutionCache* cache) : cache(cache) { thread = std::thread(&SolverWorker::Run, this); }
+
+SolverWorker::~SolverWorker() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+        cancel = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+uint64_t SolverWorker::Submit(int data[4][4], int targetVal, const CoverOptions& opts) {
+    CellMask onMask, dcMask;
+    GridToMasks(data, targetVal, onMask, dcMask);
+    uint64_t key = SolutionCache::MakeKey(onMask, dcMask, targetVal, opts);
+
+    // 快取或解答庫命中時直接當成完成的結果，同一個畫格就能 Poll 到，不必叫醒工作執行緒
+    // (增量化簡器下次會與自己記得的格子比較，略過這次仍然正確)
+    std::vector<KMapGroup> groups;
+    CoverResult stats;
+    bool found = cache && cache->Lookup(key, groups, &stats);
+    const char* source = "cache";
+    // 解答庫存的是最少項數的覆蓋，其他成本模型不能直接使用 (精確的後端都可以，結果同為最少項數)
+    if (!found && database && opts.method != CoverMethod::Greedy && opts.costModel == CostModel::Terms &&
+        database->Lookup(onMask, dcMask, groups)) {
+        stats = CoverResult();
+        stats.optimal = true;
+        stats.cost = (int)groups.size();
+        found = true;
+        source = "database";
+    }
+    // 驗證失敗的查表結果不採用，交給工作執行緒重新化簡 (成功後覆寫快取)
+    if (found && !CheckKMapSolve(groups.data(), groups.size(), onMask, dcMask, source)) found = false;
+    if (found) {
+        std::lock_guard<std::mutex> guard(lock);
+        uint64_t ticket = submittedTicket + 1;
+        hasJob = false;
+        cancel = true;
+        result.swap(groups);
+        resultStats = stats;
+        resultIsPOS = targetVal == VAL_0;
+        hasResult = true;
+        submittedTicket = ticket;
+        completedTicket = ticket;
+        return ticket;
+    }
+    return Enqueue(data, targetVal, false, opts, key);
+}
+
+uint64_t SolverWorker::SubmitDual(int data[4][4], const CoverOptions& opts) {
+    // 兩邊各自的結果仍可能在快取中，但需要兩邊都算完才能比較，一律交給工作執行緒
+    return Enqueue(data, VAL_1, true, opts, 0);
+}
+
+uint64_t SolverWorker::Enqueue(int data[4][4], int targetVal, bool dual, const CoverOptions& opts, uint64_t key) {
+    uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ticket = submittedTicket + 1;
+        memcpy(pending.data, data, sizeof(pending.data));
+        pending.targetVal = targetVal;
+        pending.dual = dual;
+        pending.opts = opts;
+        pending.ticket = ticket;
+        pending.key = key;
+        hasJob = true;
+        submittedTicket = ticket;
+        cancel = true; // 正在執行的舊工作盡快結束
+    }
+    wake.notify_one();
+    return ticket;
+}
+
+bool SolverWorker::Poll(std::vector<KMapGroup>& groups, CoverResult* stats, bool* isPOS) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!hasResult) return false;
+    groups.swap(result);
+    if (stats) *stats = resultStats;
+    if (isPOS) *isPOS = resultIsPOS;
+    hasResult = false;
+    return true;
+}
+
+void SolverWorker::Run() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this] { return stopping || hasJob; });
+            if (stopping) return;
+            job = pending;
+            hasJob = false;
+            cancel = false;
+        }
+
+        job.opts.cancel = &cancel;
+        CoverResult stats;
+        std::vector<KMapGroup> groups;
+        bool isPOS = job.targetVal == VAL_0;
+        if (job.dual) {
+            CellMask onMask, dcMask;
+            GridToMasks(job.data, VAL_1, onMask, dcMask);
+            SolveKMapDual(dualContext, onMask, dcMask, job.opts, dualResult);
+            const GroupList& best = dualResult.Cheapest();
+            groups.assign(best.begin(), best.end());
+            stats = dualResult.posCheaper ? dualResult.posStats : dualResult.sopStats;
+            isPOS = dualResult.posCheaper;
+        } else {
+            groups = solver.Solve(job.data, job.targetVal, job.opts, &stats);
+        }
+        // 被取消的工作可能只有部分結果 (之後也會被丟棄)，不驗證
+        if (!cancel) {
+            CellMask onMask, dcMask;
+            GridToMasks(job.data, isPOS ? VAL_0 : VAL_1, onMask, dcMask);
+            if (!CheckKMapSolve(groups.data(), groups.size(), onMask, dcMask, job.dual ? "dual" : "incremental")) {
+                // 不採用這次的結果，以不經過增量狀態的完整化簡重算
+                groups = SolveKMapMask(onMask, dcMask, job.opts, &stats);
+            }
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+        // 執行期間有更新的工作送達時，這次的結果已經過期 (也可能被中途取消，不放進快取)
+        if (job.ticket != submittedTicket) continue;
+        if (cache && !job.dual && (job.opts.method == CoverMethod::Greedy || stats.optimal)) {
+            cache->Store(job.key, groups, stats);
+        }
+        result.swap(groups);
+        resultStats = stats;
+        resultIsPOS = isPOS;
+        hasResult = true;
+        completedTicket = job.ticket;
+    }
+}
@@ -0,0 +1,77 @@
+// 背景化簡執行緒：UI 送出目前的格子後繼續畫舊的結果，新的格子送達時舊工作直接放棄 (latest wins)
+#ifndef SOLVER_WORKER_H
+#define SOLVER_WORKER_H
+
+#include "kmap_solver.h"
+#include "solution_cache.h"
+#include "npn_database.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SolverWorker {
+public:
+    // cache 為 nullptr 時不使用快取
+    explicit SolverWorker(SolutionCache* cache = &SolutionCache::Shared());
+    ~SolverWorker();
+
+    SolverWorker(const SolverWorker&) = delete;
+    SolverWorker& operator=(const SolverWorker&) = delete;
+
+    // 送出新的工作 (複製格子)，回傳遞增的編號；尚未開始或正在執行的舊工作會被取消
+    // 快取或解答庫中已有結果時立即完成
+    uint64_t Submit(int data[4][4], int targetVal, const CoverOptions& opts = CoverOptions());
+
+    // 同時化簡 SOP 與 POS (data 中值為 1 的格子為 on-set)，Poll 取回成本較低的一邊
+    uint64_t SubmitDual(int data[4][4], const CoverOptions& opts = CoverOptions());
+
+    // 精確模式且以項數為成本時先查預先計算的解答庫 (db 需在 worker 之後才釋放；nullptr 表示不使用)
+    void SetDatabase(const NpnDatabase* db) { database = db; }
+
+    // 有新完成的結果時寫入 groups 並回傳 true (只會拿到最新一次送出的結果)
+    // isPOS 取得結果是否為 POS 形式 (Submit 時為 targetVal == VAL_0，SubmitDual 時為成本較低的一邊)
+    bool Poll(std::vector<KMapGroup>& groups, CoverResult* stats = nullptr, bool* isPOS = nullptr);
+
+    // 最新送出的工作尚未完成
+    bool Busy() const { return completedTicket.load() != submittedTicket.load(); }
+
+private:
+    struct Job {
+        int data[4][4];
+        int targetVal;
+        bool dual;      // SubmitDual 的工作
+        CoverOptions opts;
+        uint64_t ticket;
+        uint64_t key;   // 快取的 key
+    };
+
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    bool hasJob = false;
+    Job pending;                        // 等待執行的工作 (只保留最新一個)
+    std::atomic<bool> cancel{false};    // 執行中的工作被新工作取代
+    std::atomic<uint64_t> submittedTicket{0};
+    std::atomic<uint64_t> completedTicket{0};
+
+    bool hasResult = false;
+    std::vector<KMapGroup> result;
+    CoverResult resultStats;
+    bool resultIsPOS = false;
+
+    SolutionCache* cache;
+    const NpnDatabase* database = nullptr;
+    KMapIncrementalSolver solver;       // 只在工作執行緒中使用
+    SolverContext dualContext;          // 只在工作執行緒中使用
+    DualSolution dualResult;
+    std::thread thread;                 // 最後建立，確保其他成員都已初始化
+
+    uint64_t Enqueue(int data[4][4], int targetVal, bool dual, const CoverOptions& opts, uint64_t key);
+    void Run();
+};
+
+#endif // SOLVER_WORKER_H
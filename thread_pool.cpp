@@ -0,0 +1,105 @@
+#include "thread_pool.h"
+
+// 目前執行緒在哪個池、對應哪個佇列 (非工作執行緒為 -1)
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local int currentQueue = -1;
+
+ThreadPool::ThreadPool(int numThreads) {
+    if (numThreads <= 0) numThreads = (int)std::thread::hardware_concurrency();
+    if (numThreads <= 0) numThreads = 1;
+    for (int i = 0; i < numThreads - 1; i++) queues.emplace_back(new TaskQueue());
+    for (int i = 0; i < numThreads - 1; i++) workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+ThreadPool& ThreadPool::Shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::Push(int queue, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> guard(queues[queue]->lock);
+        queues[queue]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        pending++;
+    }
+    wake.notify_one();
+}
+
+// 先從自己的佇列尾端拿 (最近放入、快取較熱)，再從其他佇列前端偷
+bool ThreadPool::TryRunOne(int self) {
+    std::function<void()> task;
+    const int n = (int)queues.size();
+    if (self >= 0) {
+        std::lock_guard<std::mutex> guard(queues[self]->lock);
+        if (!queues[self]->tasks.empty()) {
+            task = std::move(queues[self]->tasks.back());
+            queues[self]->tasks.pop_back();
+        }
+    }
+    for (int i = 1; !task && i <= n; i++) {
+        int victim = ((self < 0 ? 0 : self) + i) % n;
+        std::lock_guard<std::mutex> guard(queues[victim]->lock);
+        if (!queues[victim]->tasks.empty()) {
+            task = std::move(queues[victim]->tasks.front());
+            queues[victim]->tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+    pending--;
+    task();
+    return true;
+}
+
+void ThreadPool::WorkerLoop(int self) {
+    currentPool = this;
+    currentQueue = self;
+    while (true) {
+        if (TryRunOne(self)) continue;
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [this] { return stopping || pending > 0; });
+        if (stopping && pending == 0) return;
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++) body(i);
+        return;
+    }
+
+    std::atomic<size_t> remaining{count};
+    std::mutex doneLock;
+    std::condition_variable done;
+    const int self = (currentPool == this) ? currentQueue : -1;
+    const int n = (int)queues.size();
+    // 工作輪流分到各佇列；閒置的執行緒會再去偷，負載不均時自動平衡
+    size_t start = nextQueue.fetch_add(1);
+    for (size_t i = 0; i < count; i++) {
+        int q = (int)((start + i) % n);
+        Push(q, [&body, &remaining, &doneLock, &done, i] {
+            body(i);
+            // 在鎖內遞減：呼叫端持鎖看到 0 時，最後一個工作已不再碰 doneLock / done
+            std::lock_guard<std::mutex> guard(doneLock);
+            if (--remaining == 0) done.notify_all();
+        });
+    }
+
+    // 等待期間一起幫忙，避免巢狀呼叫時所有執行緒都卡在等待；
+    // 偷不到工作時其餘工作都已在別的執行緒上執行，睡到最後一個工作完成時被叫醒，不空轉
+    while (remaining > 0 && TryRunOne(self)) {}
+    std::unique_lock<std::mutex> lock(doneLock);
+    done.wait(lock, [&remaining] { return remaining == 0; });
+}
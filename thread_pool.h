@@ -0,0 +1,53 @@
+// 工作竊取 (work stealing) 執行緒池：每個工作執行緒有自己的佇列，空閒時從別人的佇列前端偷工作
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // numThreads = 0 時使用 hardware_concurrency；呼叫端本身也會參與執行，因此只另開 n - 1 條執行緒
+    explicit ThreadPool(int numThreads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 可同時執行的執行緒數 (含呼叫端)
+    int Size() const { return (int)workers.size() + 1; }
+
+    // 以 body(0) ... body(count - 1) 建立工作並等待全部完成
+    // 呼叫端在等待時也會執行 / 偷取工作，因此可以在工作內部巢狀呼叫
+    void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    // 全程式共用的執行緒池 (第一次使用時建立)
+    static ThreadPool& Shared();
+
+private:
+    struct TaskQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<TaskQueue>> queues; // 每條工作執行緒一個
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<size_t> pending{0}; // 尚未被取走的工作數
+    std::atomic<size_t> nextQueue{0};
+    bool stopping = false;
+
+    void Push(int queue, std::function<void()> task);
+    bool TryRunOne(int self);
+    void WorkerLoop(int self);
+};
+
+#endif // THREAD_POOL_H
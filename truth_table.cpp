@@ -0,0 +1,207 @@
+#include "truth_table.h"
+#include "bit_utils.h"
+#include <cstring>
+#include <utility>
+
+TruthTable::TruthTable(int numVars) : numVars(numVars) {
+    size_t count = numVars <= 6 ? 1 : (size_t)1 << (numVars - 6);
+    words.resize(count);
+    memset(words.data(), 0, count * sizeof(uint64_t));
+}
+
+TruthTable TruthTable::Var(int numVars, int var) {
+    TruthTable t(numVars);
+    for (size_t k = 0; k < t.words.size(); k++) {
+        if (var < 6) t.words[k] = TRUTH_VAR_MASKS[var];
+        else t.words[k] = ((k >> (var - 6)) & 1) ? ~0ull : 0;
+    }
+    t.Normalize();
+    return t;
+}
+
+TruthTable TruthTable::FromMinterms(int numVars, const std::vector<uint32_t>& minterms) {
+    TruthTable t(numVars);
+    for (uint32_t m : minterms) t.Set(m);
+    return t;
+}
+
+TruthTable TruthTable::FromCellMask(CellMask mask) {
+    TruthTable t(4);
+    t.words[0] = mask;
+    return t;
+}
+
+CellMask TruthTable::ToCellMask() const { return (CellMask)words[0]; }
+
+std::vector<uint32_t> TruthTable::Minterms() const {
+    std::vector<uint32_t> minterms;
+    for (size_t k = 0; k < words.size(); k++) {
+        for (uint64_t w = words[k]; w; w &= w - 1) minterms.push_back((uint32_t)(k * 64 + CountTrailingZeros64(w)));
+    }
+    return minterms;
+}
+
+void TruthTable::Set(uint32_t minterm, bool value) {
+    uint64_t bit = 1ull << (minterm % 64);
+    if (value) words[minterm / 64] |= bit;
+    else words[minterm / 64] &= ~bit;
+}
+
+// 6 變數以下時清掉 2^numVars 以上沒有意義的位元
+void TruthTable::Normalize() {
+    if (numVars < 6) words[0] &= (1ull << (1u << numVars)) - 1;
+}
+
+// --- 比較與計數 ---
+int TruthTable::Count() const {
+    int count = 0;
+    for (uint64_t w : words) count += PopCount64(w);
+    return count;
+}
+
+bool TruthTable::IsZero() const {
+    for (uint64_t w : words) if (w) return false;
+    return true;
+}
+
+bool TruthTable::IsOne() const {
+    TruthTable full = ~TruthTable(numVars);
+    return *this == full;
+}
+
+bool TruthTable::operator==(const TruthTable& other) const {
+    if (numVars != other.numVars) return false;
+    return memcmp(words.data(), other.words.data(), words.size() * sizeof(uint64_t)) == 0;
+}
+
+bool TruthTable::Implies(const TruthTable& other) const {
+    for (size_t k = 0; k < words.size(); k++) if (words[k] & ~other.words[k]) return false;
+    return true;
+}
+
+// --- 邏輯運算 ---
+TruthTable TruthTable::operator~() const {
+    TruthTable t = *this;
+    t.Complement();
+    return t;
+}
+
+void TruthTable::Complement() {
+    for (uint64_t& w : words) w = ~w;
+    Normalize();
+}
+
+TruthTable& TruthTable::operator&=(const TruthTable& other) {
+    for (size_t k = 0; k < words.size(); k++) words[k] &= other.words[k];
+    return *this;
+}
+
+TruthTable& TruthTable::operator|=(const TruthTable& other) {
+    for (size_t k = 0; k < words.size(); k++) words[k] |= other.words[k];
+    return *this;
+}
+
+TruthTable& TruthTable::operator^=(const TruthTable& other) {
+    for (size_t k = 0; k < words.size(); k++) words[k] ^= other.words[k];
+    return *this;
+}
+
+// --- 變數操作 ---
+// var < 6 時在 word 內平移 2^var 個位元；var >= 6 時整個 word 對調或複製
+TruthTable TruthTable::Cofactor(int var, bool value) const {
+    TruthTable t = *this;
+    if (var < 6) {
+        const uint64_t m = TRUTH_VAR_MASKS[var];
+        const int s = 1 << var;
+        for (uint64_t& w : t.words) w = value ? ((w & m) | ((w & m) >> s)) : ((w & ~m) | ((w & ~m) << s));
+    } else {
+        const size_t step = (size_t)1 << (var - 6);
+        for (size_t k = 0; k < t.words.size(); k++) {
+            if (k & step) continue;
+            uint64_t w = value ? t.words[k | step] : t.words[k];
+            t.words[k] = t.words[k | step] = w;
+        }
+    }
+    return t;
+}
+
+bool TruthTable::DependsOn(int var) const {
+    if (var < 6) {
+        const int s = 1 << var;
+        for (uint64_t w : words) if (((w >> s) ^ w) & ~TRUTH_VAR_MASKS[var]) return true;
+        return false;
+    }
+    const size_t step = (size_t)1 << (var - 6);
+    for (size_t k = 0; k < words.size(); k++) {
+        if (!(k & step) && words[k] != words[k | step]) return true;
+    }
+    return false;
+}
+
+void TruthTable::SwapVars(int a, int b) {
+    if (a == b) return;
+    if (a > b) std::swap(a, b);
+    if (b < 6) {
+        // (x_a = 1, x_b = 0) 與 (x_a = 0, x_b = 1) 的位元互換 (delta swap)
+        const uint64_t up = TRUTH_VAR_MASKS[a] & ~TRUTH_VAR_MASKS[b];
+        const uint64_t down = ~TRUTH_VAR_MASKS[a] & TRUTH_VAR_MASKS[b];
+        const int shift = (1 << b) - (1 << a);
+        for (uint64_t& w : words) w = (w & ~(up | down)) | ((w & up) << shift) | ((w & down) >> shift);
+    } else if (a < 6) {
+        // x_b 決定 word，x_a 決定 word 內的位置：兩個 word 之間互換一半的位元
+        const uint64_t m = TRUTH_VAR_MASKS[a];
+        const int s = 1 << a;
+        const size_t step = (size_t)1 << (b - 6);
+        for (size_t k = 0; k < words.size(); k++) {
+            if (k & step) continue;
+            uint64_t w0 = words[k], w1 = words[k | step];
+            words[k] = (w0 & ~m) | ((w1 & ~m) << s);
+            words[k | step] = (w1 & m) | ((w0 & m) >> s);
+        }
+    } else {
+        const size_t sa = (size_t)1 << (a - 6), sb = (size_t)1 << (b - 6);
+        for (size_t k = 0; k < words.size(); k++) {
+            if ((k & sa) && !(k & sb)) std::swap(words[k], words[k ^ sa ^ sb]);
+        }
+    }
+}
+
+void TruthTable::FlipVar(int var) {
+    if (var < 6) {
+        const uint64_t m = TRUTH_VAR_MASKS[var];
+        const int s = 1 << var;
+        for (uint64_t& w : words) w = ((w & m) >> s) | ((w & ~m) << s);
+    } else {
+        const size_t step = (size_t)1 << (var - 6);
+        for (size_t k = 0; k < words.size(); k++) {
+            if (!(k & step)) std::swap(words[k], words[k | step]);
+        }
+    }
+}
+
+void TruthTable::FlipInputs(uint32_t negMask) {
+    for (int v = 0; v < numVars; v++) if ((negMask >> v) & 1) FlipVar(v);
+}
+
+// 逐一把應該在第 p 個位置的變數換過來 (最多 numVars - 1 次交換)
+void TruthTable::PermuteInputs(const int* perm) {
+    int at[TRUTH_TABLE_MAX_VARS], pos[TRUTH_TABLE_MAX_VARS], source[TRUTH_TABLE_MAX_VARS];
+    for (int v = 0; v < numVars; v++) {
+        at[v] = pos[v] = v;
+        source[perm[v]] = v;
+    }
+    for (int p = 0; p < numVars; p++) {
+        int v = source[p];
+        if (at[p] == v) continue;
+        int q = pos[v], u = at[p];
+        SwapVars(p, q);
+        at[p] = v; pos[v] = p;
+        at[q] = u; pos[u] = q;
+    }
+}
+
+void TruthTable::ApplyNpn(const int* perm, uint32_t negMask, bool negOutput) {
+    FlipInputs(negMask);
+    PermuteInputs(perm);
+    if (negOutput) Complement();
+}
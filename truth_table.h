@@ -0,0 +1,82 @@
+// 真值表：以 64 位元 word 存放的布林函數 (6 變數以內一個 word，放在物件內；超過時為 word 陣列)
+// 變數 i 對應 minterm 的第 i 個位元 (4 變數卡諾圖時 A = 變數 3，與 CellMask 相同)
+// 餘因子、變數交換、反相、NPN 轉換等都以 word 為單位的位元運算完成，不逐格處理
+#ifndef TRUTH_TABLE_H
+#define TRUTH_TABLE_H
+
+#include "implicant_table.h"
+#include "small_vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+const int TRUTH_TABLE_MAX_VARS = 24;
+
+// 一個 word 內變數 i (< 6) 為 1 的位元位置
+constexpr uint64_t TRUTH_VAR_MASKS[6] = {
+    0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull
+};
+
+class TruthTable {
+public:
+    explicit TruthTable(int numVars = 0);
+
+    // 投影函數 f = x_var
+    static TruthTable Var(int numVars, int var);
+    static TruthTable FromMinterms(int numVars, const std::vector<uint32_t>& minterms);
+    // 4 變數卡諾圖
+    static TruthTable FromCellMask(CellMask mask);
+    CellMask ToCellMask() const;
+    std::vector<uint32_t> Minterms() const;
+
+    int NumVars() const { return numVars; }
+    size_t NumWords() const { return words.size(); }
+    const uint64_t* Words() const { return words.data(); }
+    // 直接寫入 word 時，6 變數以下須保持 2^numVars 以上的位元為 0
+    uint64_t* Words() { return words.data(); }
+
+    bool Get(uint32_t minterm) const { return (words[minterm / 64] >> (minterm % 64)) & 1; }
+    void Set(uint32_t minterm, bool value = true);
+
+    int Count() const;
+    bool IsZero() const;
+    bool IsOne() const;
+    bool operator==(const TruthTable& other) const;
+    bool operator!=(const TruthTable& other) const { return !(*this == other); }
+    // 此函數為 1 的地方 other 也都是 1
+    bool Implies(const TruthTable& other) const;
+
+    TruthTable operator~() const;
+    TruthTable& operator&=(const TruthTable& other);
+    TruthTable& operator|=(const TruthTable& other);
+    TruthTable& operator^=(const TruthTable& other);
+    TruthTable operator&(const TruthTable& other) const { TruthTable t = *this; return t &= other; }
+    TruthTable operator|(const TruthTable& other) const { TruthTable t = *this; return t |= other; }
+    TruthTable operator^(const TruthTable& other) const { TruthTable t = *this; return t ^= other; }
+
+    // f(x_var = value)，結果仍是 numVars 個變數的函數 (與 x_var 無關)
+    TruthTable Cofactor(int var, bool value) const;
+    bool DependsOn(int var) const;
+
+    // 以下為原地修改
+    void Complement();
+    // f'(x) = f(x 的第 a、b 個位元交換)
+    void SwapVars(int a, int b);
+    // f'(x) = f(x 的第 var 個位元反相)
+    void FlipVar(int var);
+    void FlipInputs(uint32_t negMask);
+    // 原本的變數 i 搬到第 perm[i] 個位置：f'(y) = f(x)，其中 y 的第 perm[i] 個位元 = x 的第 i 個位元
+    void PermuteInputs(const int* perm);
+    // 先反相 negMask 中的輸入，再依 perm 排列，最後視 negOutput 反相輸出
+    // (與 npn_database 的轉換定義相同)
+    void ApplyNpn(const int* perm, uint32_t negMask, bool negOutput);
+
+private:
+    int numVars;
+    SmallVec<uint64_t, 1> words;
+
+    void Normalize();
+};
+
+#endif // TRUTH_TABLE_H
@@ -0,0 +1,142 @@
+#include "verifier.h"
+#include "bit_utils.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+// --- 求值 ---
+// word 內的變數 (< 6) 以 TRUTH_VAR_MASKS 相 AND；word 索引上的變數直接列舉符合的 word
+TruthTable EvaluateCubes(int numVars, const Implicant* cubes, size_t count) {
+    TruthTable f(numVars);
+    uint64_t* words = f.Words();
+    const uint32_t varBits = numVars >= 32 ? ~0u : (1u << numVars) - 1;
+    const uint32_t wordBits = (uint32_t)f.NumWords() - 1;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t care = ~cubes[i].mask & varBits;
+        const uint32_t value = cubes[i].value & care;
+        uint64_t inWord = ~0ull;
+        for (int v = 0; v < 6 && v < numVars; v++) {
+            if ((care >> v) & 1) inWord &= ((value >> v) & 1) ? TRUTH_VAR_MASKS[v] : ~TRUTH_VAR_MASKS[v];
+        }
+        const uint32_t base = value >> 6, free = ~(care >> 6) & wordBits;
+        uint32_t k = 0;
+        do {
+            words[base | k] |= inWord;
+            k = (k - free) & free;
+        } while (k != 0);
+    }
+    if (numVars < 6) words[0] &= (1ull << (1u << numVars)) - 1;
+    return f;
+}
+
+// 與 IMPLICANT_TABLE 的遮罩無關：只由 care / value 算出框覆蓋的格子
+static CellMask EvaluateRect(const ImplicantRect& t) {
+    uint64_t w = ~0ull;
+    for (int v = 0; v < 4; v++) {
+        if ((t.care >> v) & 1) w &= ((t.value >> v) & 1) ? TRUTH_VAR_MASKS[v] : ~TRUTH_VAR_MASKS[v];
+    }
+    return (CellMask)w;
+}
+
+// --- 比對 ---
+bool VerifyCover(const TruthTable& cover, const TruthTable& onSet, const TruthTable& dcSet, VerifyReport* report) {
+    VerifyReport r;
+    if (cover.NumVars() != onSet.NumVars() || dcSet.NumVars() != onSet.NumVars()) {
+        r.missed = (uint64_t)onSet.Count();
+        if (report) *report = r;
+        return false;
+    }
+    const uint64_t* f = cover.Words();
+    const uint64_t* on = onSet.Words();
+    const uint64_t* dc = dcSet.Words();
+    for (size_t k = 0; k < onSet.NumWords(); k++) {
+        uint64_t missed = on[k] & ~f[k];
+        uint64_t extra = f[k] & ~(on[k] | dc[k]);
+        if (missed) {
+            if (r.firstMissed < 0) r.firstMissed = (int64_t)(k * 64 + CountTrailingZeros64(missed));
+            r.missed += PopCount64(missed);
+        }
+        if (extra) {
+            if (r.firstExtra < 0) r.firstExtra = (int64_t)(k * 64 + CountTrailingZeros64(extra));
+            r.extra += PopCount64(extra);
+        }
+    }
+    if (report) *report = r;
+    return r.Ok();
+}
+
+bool VerifyCubes(const Implicant* cubes, size_t count, const TruthTable& onSet, const TruthTable& dcSet,
+                 VerifyReport* report) {
+    return VerifyCover(EvaluateCubes(onSet.NumVars(), cubes, count), onSet, dcSet, report);
+}
+
+bool VerifyKMapGroups(const KMapGroup* groups, size_t count, CellMask onMask, CellMask dcMask, VerifyReport* report) {
+    VerifyReport r;
+    CellMask cover = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (groups[i].rect < 0 || groups[i].rect >= IMPLICANT_COUNT) { r.badGroups++; continue; }
+        CellMask cells = EvaluateRect(IMPLICANT_TABLE.rects[groups[i].rect]);
+        if (cells != groups[i].mask) r.badGroups++;
+        cover = (CellMask)(cover | cells);
+    }
+    const uint32_t missed = onMask & ~cover & 0xFFFF;
+    const uint32_t extra = cover & ~(onMask | dcMask) & 0xFFFF;
+    r.missed = PopCount32(missed);
+    r.extra = PopCount32(extra);
+    if (missed) r.firstMissed = CountTrailingZeros64(missed);
+    if (extra) r.firstExtra = CountTrailingZeros64(extra);
+    if (report) *report = r;
+    return r.Ok();
+}
+
+// --- 批次驗證 ---
+size_t VerifyKMapBatch(const KMapVerifyJob* jobs, size_t count, uint8_t* ok, bool parallel) {
+    const size_t CHUNK = 4096;
+    std::atomic<size_t> failures{0};
+    auto run = [&](size_t begin, size_t end) {
+        size_t local = 0;
+        for (size_t i = begin; i < end; i++) {
+            const KMapVerifyJob& job = jobs[i];
+            bool pass = VerifyKMapGroups(job.groups, job.count, job.onMask, job.dcMask);
+            if (ok) ok[i] = pass ? 1 : 0;
+            if (!pass) local++;
+        }
+        failures += local;
+    };
+    const size_t chunks = (count + CHUNK - 1) / CHUNK;
+    if (parallel && chunks > 1) {
+        ThreadPool::Shared().ParallelFor(chunks, [&](size_t c) { run(c * CHUNK, std::min(count, (c + 1) * CHUNK)); });
+    } else {
+        run(0, count);
+    }
+    return failures;
+}
+
+// --- 每次化簡後的檢查 ---
+#if !defined(NDEBUG) || defined(KMAP_VERIFY_SOLVES)
+static std::atomic<bool> verifyEnabled{true};
+#else
+static std::atomic<bool> verifyEnabled{false};
+#endif
+static std::atomic<uint64_t> verifyChecked{0};
+static std::atomic<uint64_t> verifyFailed{0};
+
+void SetSolveVerification(bool enabled) { verifyEnabled = enabled; }
+bool SolveVerificationEnabled() { return verifyEnabled; }
+
+VerifyCounters SolveVerifyCounters() { return { verifyChecked.load(), verifyFailed.load() }; }
+
+bool CheckKMapSolve(const KMapGroup* groups, size_t count, CellMask onMask, CellMask dcMask, const char* source) {
+    if (!verifyEnabled) return true;
+    verifyChecked++;
+    VerifyReport r;
+    if (VerifyKMapGroups(groups, count, onMask, dcMask, &r)) return true;
+    verifyFailed++;
+    char formula[256];
+    FormatFormula(groups, count, false, formula, sizeof(formula));
+    fprintf(stderr, "verify failed (%s): on=%04X dc=%04X missed=%llu extra=%llu bad groups=%d  %s\n", source,
+            (unsigned)onMask, (unsigned)dcMask, (unsigned long long)r.missed, (unsigned long long)r.extra,
+            r.badGroups, formula);
+    return false;
+}
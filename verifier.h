@@ -0,0 +1,59 @@
+// 化簡結果驗證：把選出的乘積項在全部 2^N 個輸入上重新求值 (每個 word 一次 64 個輸入)，
+// 與 on-set / Don't Care 比對：目標 minterm 必須被覆蓋，非目標且非 Don't Care 的 minterm 不可被覆蓋
+// 卡諾圖的框由 IMPLICANT_TABLE 的 care / value (即公式文字) 求值，不直接相信框記錄的格子遮罩
+#ifndef VERIFIER_H
+#define VERIFIER_H
+
+#include "kmap_solver.h"
+#include <cstddef>
+#include <cstdint>
+
+struct VerifyReport {
+    uint64_t missed = 0;    // 沒被覆蓋的目標 minterm 數
+    uint64_t extra = 0;     // 被覆蓋的非目標、非 Don't Care minterm 數
+    int64_t firstMissed = -1;
+    int64_t firstExtra = -1;
+    int badGroups = 0;      // 卡諾圖：框的格子遮罩與 care / value 求值的結果不同
+
+    bool Ok() const { return missed == 0 && extra == 0 && badGroups == 0; }
+};
+
+// 乘積項列表 (QM / ISOP 的格式) 的函數
+TruthTable EvaluateCubes(int numVars, const Implicant* cubes, size_t count);
+
+// onSet <= cover <= onSet | dcSet
+bool VerifyCover(const TruthTable& cover, const TruthTable& onSet, const TruthTable& dcSet, VerifyReport* report = nullptr);
+bool VerifyCubes(const Implicant* cubes, size_t count, const TruthTable& onSet, const TruthTable& dcSet,
+                 VerifyReport* report = nullptr);
+
+// onMask 為框要覆蓋的格子 (POS 時為 0 的格子)
+bool VerifyKMapGroups(const KMapGroup* groups, size_t count, CellMask onMask, CellMask dcMask,
+                      VerifyReport* report = nullptr);
+
+// --- 批次驗證 ---
+struct KMapVerifyJob {
+    CellMask onMask;
+    CellMask dcMask;
+    const KMapGroup* groups;
+    size_t count;
+};
+
+// 回傳失敗的數量；ok 不為 nullptr 時寫入每一筆的結果
+// parallel 時大批次分段交給共用執行緒池
+size_t VerifyKMapBatch(const KMapVerifyJob* jobs, size_t count, uint8_t* ok = nullptr, bool parallel = true);
+
+// --- 每次化簡後的檢查 ---
+// Debug 版 (未定義 NDEBUG) 預設開啟；Release 版需定義 KMAP_VERIFY_SOLVES (CMake 選項) 或執行期呼叫 SetSolveVerification
+void SetSolveVerification(bool enabled);
+bool SolveVerificationEnabled();
+
+struct VerifyCounters {
+    uint64_t checked;
+    uint64_t failed;
+};
+VerifyCounters SolveVerifyCounters();
+
+// 關閉時直接回傳 true；開啟時驗證並計數，失敗時把格子與公式輸出到 stderr (source 標示結果來源)
+bool CheckKMapSolve(const KMapGroup* groups, size_t count, CellMask onMask, CellMask dcMask, const char* source);
+
+#endif // VERIFIER_H